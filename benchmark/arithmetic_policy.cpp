@@ -0,0 +1,100 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <stdexcept>
+
+#include <type_safe/arithmetic_policy.hpp>
+#include <type_safe/integer.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    // like checked_arithmetic but with the given overflow check implementation,
+    // so the portable and builtin checks can be compared in one build
+#define TYPE_SAFE_BENCHMARK_MAKE_KERNEL(Name, Check, Op)                                           \
+    template <class Tag, typename T>                                                               \
+    TYPE_SAFE_BENCHMARK_NOINLINE void Name(const T* a, const T* b, T* out, std::size_t n)          \
+    {                                                                                              \
+        for (std::size_t i = 0u; i != n; ++i)                                                      \
+            out[i] = ts::detail::Check(Tag{}, a[i], b[i]) ?                                        \
+                         throw std::overflow_error("overflow") :                                   \
+                         T(a[i] Op b[i]);                                                          \
+    }                                                                                              \
+                                                                                                   \
+    template <typename T>                                                                          \
+    TYPE_SAFE_BENCHMARK_NOINLINE void Name##_raw(const T* a, const T* b, T* out, std::size_t n)    \
+    {                                                                                              \
+        for (std::size_t i = 0u; i != n; ++i)                                                      \
+            out[i] = T(a[i] Op b[i]);                                                              \
+    }                                                                                              \
+                                                                                                   \
+    template <typename T>                                                                          \
+    TYPE_SAFE_BENCHMARK_NOINLINE void Name##_checked(const T* a, const T* b, T* out,               \
+                                                     std::size_t n)                                \
+    {                                                                                              \
+        using integer = ts::integer<T, ts::checked_arithmetic>;                                    \
+        for (std::size_t i = 0u; i != n; ++i)                                                      \
+            out[i] = static_cast<T>(integer(a[i]) Op integer(b[i]));                               \
+    }
+
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(addition, will_addition_error, +)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(subtraction, will_subtraction_error, -)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(multiplication, will_multiplication_error, *)
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_KERNEL
+
+    // signs are mixed, so every branch of the portable checks is taken,
+    // but no operation over/underflows
+    template <typename T>
+    T lhs(std::size_t i)
+    {
+        return std::is_signed<T>::value && i % 3u == 0u ? T(0) - T(100 + i % 100) :
+                                                          T(100 + i % 100);
+    }
+
+    template <typename T>
+    T rhs(std::size_t i)
+    {
+        return std::is_signed<T>::value && i % 5u == 0u ? T(0) - T(1 + i % 97) : T(1 + i % 97);
+    }
+
+    template <typename T>
+    benchmark make(const std::string& group, std::string name, binary_kernel<T, T> kernel)
+    {
+        return make_binary(group, std::move(name), kernel, &lhs<T>, &rhs<T>);
+    }
+
+#if TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+#define TYPE_SAFE_BENCHMARK_MAKE_BUILTIN(T, Name, Op)                                              \
+    make<T>("overflow check " #T ": a " #Op " b", "builtin",                                       \
+            &Name<ts::detail::builtin_integer_tag, T>),
+#else
+#define TYPE_SAFE_BENCHMARK_MAKE_BUILTIN(T, Name, Op)
+#endif
+
+#define TYPE_SAFE_BENCHMARK_MAKE_GROUP(T, Name, Op)                                                \
+    make<T>("overflow check " #T ": a " #Op " b", #T, &Name##_raw<T>),                             \
+        make<T>("overflow check " #T ": a " #Op " b", "portable",                                  \
+                &Name<ts::detail::integer_tag_for<T>, T>),                                         \
+        TYPE_SAFE_BENCHMARK_MAKE_BUILTIN(T, Name, Op)                                              \
+            make<T>("overflow check " #T ": a " #Op " b", "checked_arithmetic",                    \
+                    &Name##_checked<T>)
+
+#define TYPE_SAFE_BENCHMARK_MAKE_TYPE(T)                                                           \
+    TYPE_SAFE_BENCHMARK_MAKE_GROUP(T, addition, +),                                                \
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(T, subtraction, -),                                         \
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(T, multiplication, *)
+
+    const registrar arithmetic_policy_benchmarks = {TYPE_SAFE_BENCHMARK_MAKE_TYPE(int),
+                                                    TYPE_SAFE_BENCHMARK_MAKE_TYPE(unsigned),
+                                                    TYPE_SAFE_BENCHMARK_MAKE_TYPE(long long)};
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_TYPE
+#undef TYPE_SAFE_BENCHMARK_MAKE_GROUP
+#undef TYPE_SAFE_BENCHMARK_MAKE_BUILTIN
+} // namespace
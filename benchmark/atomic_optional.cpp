@@ -0,0 +1,111 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <type_safe/atomic_optional.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    constexpr std::size_t thread_count = 4u;
+
+    // what one would write without an atomic optional
+    struct locked_optional
+    {
+        std::mutex                  mutex;
+        ts::optional<std::uint32_t> value;
+    };
+
+    //=== kernels ===//
+    // every eighth operation updates the value, the others read it, like a shared configuration
+    TYPE_SAFE_BENCHMARK_NOINLINE std::uint32_t read_mostly_locked(locked_optional* shared,
+                                                                  std::size_t      n)
+    {
+        std::uint32_t sum = 0u;
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (i % 8u == 0u)
+                shared->value = std::uint32_t(i);
+            else
+                sum += shared->value.value_or(0u);
+        }
+        return sum;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE std::uint32_t read_mostly_atomic(
+        ts::atomic_optional<std::uint32_t>* shared, std::size_t n)
+    {
+        std::uint32_t sum = 0u;
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            if (i % 8u == 0u)
+                shared->store(std::uint32_t(i), std::memory_order_release);
+            else
+                sum += shared->load(std::memory_order_acquire).value_or(0u);
+        }
+        return sum;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE std::uint32_t increment_locked(locked_optional* shared,
+                                                                std::size_t      n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->value = shared->value.value_or(0u) + 1u;
+        }
+        return 0u;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE std::uint32_t increment_atomic(
+        ts::atomic_optional<std::uint32_t>* shared, std::size_t n)
+    {
+        auto expected = shared->load(std::memory_order_relaxed);
+        for (std::size_t i = 0u; i != n; ++i)
+            while (!shared->compare_exchange_weak(expected, expected.value_or(0u) + 1u))
+            {
+            }
+        return 0u;
+    }
+
+    //=== contention ===//
+    // runs `kernel` on the same object in `thread_count` threads at the same time
+    template <typename Shared>
+    benchmark make_contended(const std::string& group, const std::string& name,
+                             std::uint32_t (*kernel)(Shared*, std::size_t))
+    {
+        auto shared = std::make_shared<Shared>();
+        return {group, name, address_of(kernel), block_size * thread_count,
+                [=](std::size_t iterations) {
+                    std::vector<std::thread> threads;
+                    for (std::size_t t = 0u; t != thread_count; ++t)
+                        threads.emplace_back([=] {
+                            auto result = kernel(shared.get(), iterations * block_size);
+                            do_not_optimize(result);
+                        });
+                    for (auto& thread : threads)
+                        thread.join();
+                }};
+    }
+
+    const registrar atomic_optional_benchmarks =
+        {make_contended("optional<uint32_t>, 4 threads: read mostly", "mutex + optional",
+                        &read_mostly_locked),
+         make_contended("optional<uint32_t>, 4 threads: read mostly", "atomic_optional",
+                        &read_mostly_atomic),
+         make_contended("optional<uint32_t>, 4 threads: increment", "mutex + optional",
+                        &increment_locked),
+         make_contended("optional<uint32_t>, 4 threads: increment", "atomic_optional",
+                        &increment_atomic)};
+} // namespace
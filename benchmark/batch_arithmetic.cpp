@@ -0,0 +1,104 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/batch_arithmetic.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    template <typename Raw>
+    TYPE_SAFE_BENCHMARK_NOINLINE void raw_addition(const Raw* a, const Raw* b, Raw* out,
+                                                   std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] + b[i];
+    }
+
+    template <typename Int>
+    TYPE_SAFE_BENCHMARK_NOINLINE void element_addition(const Int* a, const Int* b, Int* out,
+                                                       std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] + b[i];
+    }
+
+    template <typename Int>
+    TYPE_SAFE_BENCHMARK_NOINLINE void batch_addition(const Int* a, const Int* b, Int* out,
+                                                     std::size_t n)
+    {
+        ts::add(ts::make_array_ref(out, n), ts::make_array_ref(a, n), ts::make_array_ref(b, n));
+    }
+
+    template <typename Raw>
+    TYPE_SAFE_BENCHMARK_NOINLINE void raw_multiplication(const Raw* a, const Raw* b, Raw* out,
+                                                         std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] * b[i];
+    }
+
+    template <typename Int>
+    TYPE_SAFE_BENCHMARK_NOINLINE void element_multiplication(const Int* a, const Int* b,
+                                                             Int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] * b[i];
+    }
+
+    template <typename Int>
+    TYPE_SAFE_BENCHMARK_NOINLINE void batch_multiplication(const Int* a, const Int* b, Int* out,
+                                                           std::size_t n)
+    {
+        ts::multiply(ts::make_array_ref(out, n), ts::make_array_ref(a, n),
+                     ts::make_array_ref(b, n));
+    }
+
+    template <typename T>
+    T lhs(std::size_t i)
+    {
+        return T(static_cast<typename T::integer_type>(100 + i % 100));
+    }
+
+    template <typename T>
+    T rhs(std::size_t i)
+    {
+        return T(static_cast<typename T::integer_type>(1 + i % 97));
+    }
+
+    template <typename Raw>
+    Raw raw_lhs(std::size_t i)
+    {
+        return Raw(100 + i % 100);
+    }
+
+    template <typename Raw>
+    Raw raw_rhs(std::size_t i)
+    {
+        return Raw(1 + i % 97);
+    }
+
+#define TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, Policy, Name, Op)                                      \
+    make_binary("batch integer<" #Raw ", " #Policy ">: a " #Op " b", #Raw, &raw_##Name<Raw>,       \
+                &raw_lhs<Raw>, &raw_rhs<Raw>),                                                     \
+        make_binary("batch integer<" #Raw ", " #Policy ">: a " #Op " b", "operator" #Op,           \
+                    &element_##Name<ts::integer<Raw, ts::Policy>>,                                 \
+                    &lhs<ts::integer<Raw, ts::Policy>>, &rhs<ts::integer<Raw, ts::Policy>>),       \
+        make_binary("batch integer<" #Raw ", " #Policy ">: a " #Op " b", "batch",                  \
+                    &batch_##Name<ts::integer<Raw, ts::Policy>>,                                   \
+                    &lhs<ts::integer<Raw, ts::Policy>>, &rhs<ts::integer<Raw, ts::Policy>>)
+
+    const registrar batch_arithmetic_benchmarks =
+        {TYPE_SAFE_BENCHMARK_MAKE_GROUP(int, checked_arithmetic, addition, +),
+         TYPE_SAFE_BENCHMARK_MAKE_GROUP(int, checked_arithmetic, multiplication, *),
+         TYPE_SAFE_BENCHMARK_MAKE_GROUP(long long, checked_arithmetic, addition, +),
+         TYPE_SAFE_BENCHMARK_MAKE_GROUP(long long, checked_arithmetic, multiplication, *),
+         TYPE_SAFE_BENCHMARK_MAKE_GROUP(int, undefined_behavior_arithmetic, addition, +),
+         TYPE_SAFE_BENCHMARK_MAKE_GROUP(long long, undefined_behavior_arithmetic, addition, +)};
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_GROUP
+} // namespace
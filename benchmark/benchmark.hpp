@@ -0,0 +1,187 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_BENCHMARK_BENCHMARK_HPP_INCLUDED
+#define TYPE_SAFE_BENCHMARK_BENCHMARK_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__)
+#define TYPE_SAFE_BENCHMARK_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define TYPE_SAFE_BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define TYPE_SAFE_BENCHMARK_NOINLINE
+#endif
+
+namespace type_safe_benchmark
+{
+    /// Number of elements processed by one iteration of an element-wise benchmark.
+    constexpr std::size_t block_size = 1024u;
+
+    /// \effects Forces the compiler to assume `val` is read,
+    /// so the computation producing it cannot be removed.
+    template <typename T>
+    void do_not_optimize(const T& val)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&val) : "memory");
+#else
+        static const volatile void* sink;
+        sink = &val;
+#endif
+    }
+
+    /// A single benchmark.
+    ///
+    /// Every benchmark is run next to the benchmarks of the same `group`,
+    /// the first one registered for a group is the baseline - usually the raw built-in type.
+    struct benchmark
+    {
+        std::string group; // the operation, e.g. `integer<int>: a + b`
+        std::string name;  // the type performing the operation, e.g. `checked_arithmetic`
+        const void* kernel;            // the out-of-line function whose code size is reported
+        std::size_t ops_per_iteration; // number of operations one call to `run` performs
+        std::function<void(std::size_t)> run; // runs the given number of iterations
+    };
+
+    /// \returns All registered benchmarks.
+    std::vector<benchmark>& registry();
+
+    /// \returns The number of calls to the global `operator new` so far.
+    std::size_t allocation_count() noexcept;
+
+    /// Registers benchmarks on construction.
+    /// Use it as a namespace-scope object in the benchmark translation units.
+    struct registrar
+    {
+        registrar(std::initializer_list<benchmark> benchmarks)
+        {
+            for (auto& b : benchmarks)
+                registry().push_back(b);
+        }
+    };
+
+    /// \returns The address of a function as an object pointer, for code size lookup.
+    template <typename Func>
+    const void* address_of(Func* f) noexcept
+    {
+        return reinterpret_cast<const void*>(f);
+    }
+
+    //=== element-wise benchmarks ===//
+    template <typename In, typename Out>
+    using unary_kernel = void (*)(const In*, Out*, std::size_t);
+
+    template <typename In, typename Out>
+    using binary_kernel = void (*)(const In*, const In*, Out*, std::size_t);
+
+    /// A block of `block_size` objects.
+    /// Unlike [std::vector<T>]() it works for `bool` and types without default constructor.
+    template <typename T>
+    class block
+    {
+    public:
+        /// \effects Creates each element by default construction.
+        block() : block([](std::size_t) { return T(); })
+        {
+        }
+
+        /// \effects Creates the `i`th element from `gen(i)`.
+        template <class Generator>
+        explicit block(Generator gen)
+        : data_(static_cast<T*>(::operator new(block_size * sizeof(T))))
+        {
+            for (std::size_t i = 0u; i != block_size; ++i)
+                ::new (static_cast<void*>(data_ + i)) T(gen(i));
+        }
+
+        block(const block&) = delete;
+        block& operator=(const block&) = delete;
+
+        ~block() noexcept
+        {
+            for (std::size_t i = 0u; i != block_size; ++i)
+                data_[i].~T();
+            ::operator delete(data_);
+        }
+
+        T* data() noexcept
+        {
+            return data_;
+        }
+
+    private:
+        T* data_;
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        // the output block is a copy of the input if they have the same type,
+        // so types without default constructor can be used
+        template <typename T>
+        std::shared_ptr<block<T>> make_output(std::true_type, const std::shared_ptr<block<T>>& in)
+        {
+            return std::make_shared<block<T>>([&](std::size_t i) { return in->data()[i]; });
+        }
+
+        template <typename T, typename U>
+        std::shared_ptr<block<T>> make_output(std::false_type, const std::shared_ptr<block<U>>&)
+        {
+            return std::make_shared<block<T>>();
+        }
+
+        template <typename T, typename U>
+        std::shared_ptr<block<T>> make_output(const std::shared_ptr<block<U>>& in)
+        {
+            return make_output<T>(std::is_same<T, U>{}, in);
+        }
+    } // namespace detail
+
+    /// \returns A benchmark calling `kernel` on a block of inputs created by `gen(i)`.
+    template <typename In, typename Out, class Generator>
+    benchmark make_unary(std::string group, std::string name, unary_kernel<In, Out> kernel,
+                         Generator gen)
+    {
+        auto in  = std::make_shared<block<In>>(gen);
+        auto out = detail::make_output<Out>(in);
+        return {std::move(group), std::move(name), address_of(kernel), block_size,
+                [=](std::size_t iterations) {
+                    for (std::size_t i = 0u; i != iterations; ++i)
+                    {
+                        kernel(in->data(), out->data(), block_size);
+                        do_not_optimize(*out->data());
+                    }
+                }};
+    }
+
+    /// \returns A benchmark calling `kernel` on two blocks of inputs created by `gen_a(i)` and `gen_b(i)`.
+    template <typename In, typename Out, class GeneratorA, class GeneratorB>
+    benchmark make_binary(std::string group, std::string name, binary_kernel<In, Out> kernel,
+                          GeneratorA gen_a, GeneratorB gen_b)
+    {
+        auto a   = std::make_shared<block<In>>(gen_a);
+        auto b   = std::make_shared<block<In>>(gen_b);
+        auto out = detail::make_output<Out>(a);
+        return {std::move(group), std::move(name), address_of(kernel), block_size,
+                [=](std::size_t iterations) {
+                    for (std::size_t i = 0u; i != iterations; ++i)
+                    {
+                        kernel(a->data(), b->data(), out->data(), block_size);
+                        do_not_optimize(*out->data());
+                    }
+                }};
+    }
+} // namespace type_safe_benchmark
+
+#endif // TYPE_SAFE_BENCHMARK_BENCHMARK_HPP_INCLUDED
@@ -0,0 +1,53 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/boolean.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void negation(const bool* a, bool* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<bool>(!T(a[i]));
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void equal(const bool* a, const bool* b, bool* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<bool>(T(a[i]) == T(b[i]));
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void logical_and(const bool* a, const bool* b, bool* out,
+                                                  std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = T(a[i]) && T(b[i]);
+    }
+
+    bool lhs(std::size_t i)
+    {
+        return (i * 2654435761u >> 7) & 1u;
+    }
+
+    bool rhs(std::size_t i)
+    {
+        return (i * 40503u >> 5) & 1u;
+    }
+
+    const registrar boolean_benchmarks =
+        {make_unary("boolean: !a", "bool", &negation<bool>, &lhs),
+         make_unary("boolean: !a", "boolean", &negation<ts::boolean>, &lhs),
+         make_binary("boolean: a == b", "bool", &equal<bool>, &lhs, &rhs),
+         make_binary("boolean: a == b", "boolean", &equal<ts::boolean>, &lhs, &rhs),
+         make_binary("boolean: a && b", "bool", &logical_and<bool>, &lhs, &rhs),
+         make_binary("boolean: a && b", "boolean", &logical_and<ts::boolean>, &lhs, &rhs)};
+} // namespace
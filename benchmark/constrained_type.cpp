@@ -0,0 +1,362 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <cstdint>
+#include <vector>
+
+#include <type_safe/bounded_type.hpp>
+#include <type_safe/constrained_span.hpp>
+#include <type_safe/constrained_type.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    //=== non_null ===//
+    int values[block_size];
+
+    const int* make_pointer(std::size_t i)
+    {
+        return &values[i];
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void deref_raw(const int* const* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = *a[i];
+    }
+
+    template <class Verifier>
+    TYPE_SAFE_BENCHMARK_NOINLINE void deref_non_null(const int* const* a, int* out, std::size_t n)
+    {
+        using type = ts::constrained_type<const int*, ts::constraints::non_null, Verifier>;
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = *type(a[i]).get_value();
+    }
+
+    //=== bounded/clamped ===//
+    int make_value(std::size_t i)
+    {
+        return int(i % 150) - 25;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void bounded_raw(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] + 25;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void bounded(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = ts::make_bounded(a[i] + 25, 0, 150).get_value();
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void static_bounded(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = ts::static_bounded_type<int, 0, 150>(a[i] + 25).get_value();
+    }
+
+    //=== bounded arithmetic ===//
+    using bounded_percent        = ts::bounded_type<int, true, true>;
+    using static_bounded_percent = ts::static_bounded_type<int, 0, 100>;
+
+    template <typename T>
+    T make_percent(std::size_t i);
+
+    template <>
+    int make_percent<int>(std::size_t i)
+    {
+        return int(i % 101);
+    }
+
+    template <>
+    bounded_percent make_percent<bounded_percent>(std::size_t i)
+    {
+        return ts::make_bounded(make_percent<int>(i), 0, 100);
+    }
+
+    template <>
+    static_bounded_percent make_percent<static_bounded_percent>(std::size_t i)
+    {
+        return static_bounded_percent(make_percent<int>(i));
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void add_raw(const int* a, const int* b, int* out,
+                                              std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] + b[i];
+    }
+
+    // the bounds of the sum are computed and checked at runtime
+    TYPE_SAFE_BENCHMARK_NOINLINE void add_bounded(const bounded_percent* a,
+                                                  const bounded_percent* b, int* out,
+                                                  std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            auto& x = a[i].get_constraint();
+            auto& y = b[i].get_constraint();
+            out[i]  = ts::make_bounded(a[i].get_value() + b[i].get_value(),
+                                      x.get_lower_bound() + y.get_lower_bound(),
+                                      x.get_upper_bound() + y.get_upper_bound())
+                         .get_value();
+        }
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void add_static_bounded(const static_bounded_percent* a,
+                                                         const static_bounded_percent* b,
+                                                         int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = (a[i] + b[i]).get_value();
+    }
+
+    //=== interval arithmetic ===//
+    // a * b + a of 8 bit samples, stored as 16 bit integer
+    // the samples are small enough that the result always fits
+    using bounded_sample        = ts::bounded_type<int, true, true>;
+    using static_bounded_sample = ts::static_bounded_type<int, 0, 255>;
+
+    template <typename T>
+    T make_sample(std::size_t i);
+
+    template <>
+    int make_sample<int>(std::size_t i)
+    {
+        return int(i * 37u % 128u);
+    }
+
+    template <>
+    bounded_sample make_sample<bounded_sample>(std::size_t i)
+    {
+        return ts::make_bounded(make_sample<int>(i), 0, 255);
+    }
+
+    template <>
+    static_bounded_sample make_sample<static_bounded_sample>(std::size_t i)
+    {
+        return static_bounded_sample(make_sample<int>(i));
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void multiply_add_raw(const int* a, const int* b,
+                                                       std::int16_t* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<std::int16_t>(a[i] * b[i] + a[i]);
+    }
+
+    // every intermediate result and the conversion is checked at runtime
+    TYPE_SAFE_BENCHMARK_NOINLINE void multiply_add_bounded(const bounded_sample* a,
+                                                           const bounded_sample* b,
+                                                           std::int16_t* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            auto& x       = a[i].get_constraint();
+            auto& y       = b[i].get_constraint();
+            auto  product = ts::make_bounded(a[i].get_value() * b[i].get_value(),
+                                            x.get_lower_bound() * y.get_lower_bound(),
+                                            x.get_upper_bound() * y.get_upper_bound());
+            auto sum = ts::make_bounded(product.get_value() + a[i].get_value(),
+                                        product.get_constraint().get_lower_bound()
+                                            + x.get_lower_bound(),
+                                        product.get_constraint().get_upper_bound()
+                                            + x.get_upper_bound());
+            out[i] = static_cast<std::int16_t>(
+                ts::make_bounded(sum.get_value(), 0, int(INT16_MAX)).get_value());
+        }
+    }
+
+    // the intermediate results are not checked, the conversion only checks the upper bound
+    TYPE_SAFE_BENCHMARK_NOINLINE void multiply_add_static_bounded(const static_bounded_sample* a,
+                                                                  const static_bounded_sample* b,
+                                                                  std::int16_t* out,
+                                                                  std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = ts::bounded_cast<std::int16_t>(a[i] * b[i] + a[i]);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void clamped_raw(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] < 0 ? 0 : (a[i] > 100 ? 100 : a[i]);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void clamped(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = ts::make_clamped(a[i], 0, 100).get_value();
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void clamped_range(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i];
+        ts::clamp(ts::constraints::closed_interval<int>(0, 100), ts::array_ref<int>(out, n));
+    }
+
+    template <class Vector>
+    void copy_clamped(const Vector& vec, int* out)
+    {
+        for (std::size_t i = 0u; i != vec.size(); ++i)
+            out[i] = vec[i].get_value();
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void clamped_vector(const int* a, int* out, std::size_t n)
+    {
+        std::vector<ts::clamped_type<int>> vec;
+        vec.reserve(n);
+        for (std::size_t i = 0u; i != n; ++i)
+            vec.push_back(ts::make_clamped(a[i], 0, 100));
+        copy_clamped(vec, out);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void clamped_vector_bulk(const int* a, int* out, std::size_t n)
+    {
+        auto vec = ts::make_clamped(ts::constraints::closed_interval<int>(0, 100),
+                                    ts::array_ref<const int>(a, n));
+        copy_clamped(vec, out);
+    }
+
+    //=== constrain_all ===//
+    struct is_percent
+    {
+        bool operator()(int i) const noexcept
+        {
+            return i >= 0 && i <= 100;
+        }
+    };
+
+    using percent = ts::constrained_type<int, is_percent>;
+
+    int make_percent_value(std::size_t i)
+    {
+        return int(i % 101);
+    }
+
+    template <class Vector>
+    void copy_percent(const Vector& vec, int* out)
+    {
+        for (std::size_t i = 0u; i != vec.size(); ++i)
+            out[i] = vec[i].get_value();
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void check_each(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            if (!is_percent{}(a[i]))
+            {
+                out[0] = -int(i);
+                return;
+            }
+        out[0] = 0;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void check_all(const int* a, int* out, std::size_t n)
+    {
+        auto batch = ts::constrain_all(ts::array_ref<const int>(a, n), is_percent{});
+        out[0]     = batch ? 0 : -int(batch.first_invalid());
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void validate_each(const int* a, int* out, std::size_t n)
+    {
+        std::vector<percent> vec;
+        vec.reserve(n);
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            if (!is_percent{}(a[i]))
+            {
+                out[0] = -int(i);
+                return;
+            }
+            vec.push_back(percent(a[i]));
+        }
+        copy_percent(vec, out);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void validate_all(const int* a, int* out, std::size_t n)
+    {
+        auto batch = ts::constrain_all(ts::array_ref<const int>(a, n), is_percent{});
+        if (!batch)
+        {
+            out[0] = -int(batch.first_invalid());
+            return;
+        }
+        copy_percent(batch.to_vector(), out);
+    }
+
+    //=== constrained_span ===//
+    TYPE_SAFE_BENCHMARK_NOINLINE void view_vector(const int* a, int* out, std::size_t n)
+    {
+        std::vector<percent> vec;
+        vec.reserve(n);
+        for (std::size_t i = 0u; i != n; ++i)
+            vec.push_back(percent(a[i]));
+        copy_percent(vec, out);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void view_span(const int* a, int* out, std::size_t n)
+    {
+        ts::constrained_span<const int, is_percent> span(ts::array_ref<const int>(a, n));
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = span.get_value(i);
+    }
+
+    const registrar constrained_type_benchmarks =
+        {make_unary("constrained_type<const int*, non_null>: *get_value()", "const int*",
+                    &deref_raw, &make_pointer),
+         make_unary("constrained_type<const int*, non_null>: *get_value()",
+                    "assertion_verifier", &deref_non_null<ts::assertion_verifier>,
+                    &make_pointer),
+         make_unary("constrained_type<const int*, non_null>: *get_value()", "null_verifier",
+                    &deref_non_null<ts::null_verifier>, &make_pointer),
+         make_unary("bounded_type<int>: make_bounded()", "int", &bounded_raw, &make_value),
+         make_unary("bounded_type<int>: make_bounded()", "bounded_type<int>", &bounded,
+                    &make_value),
+         make_unary("bounded_type<int>: make_bounded()", "static_bounded_type<int>",
+                    &static_bounded, &make_value),
+         make_binary("bounded_type<int>: a + b", "int", &add_raw, &make_percent<int>,
+                     &make_percent<int>),
+         make_binary("bounded_type<int>: a + b", "bounded_type<int>", &add_bounded,
+                     &make_percent<bounded_percent>, &make_percent<bounded_percent>),
+         make_binary("bounded_type<int>: a + b", "static_bounded_type<int>", &add_static_bounded,
+                     &make_percent<static_bounded_percent>,
+                     &make_percent<static_bounded_percent>),
+         make_binary("static_bounded_type<int>: a * b + a", "int", &multiply_add_raw,
+                     &make_sample<int>, &make_sample<int>),
+         make_binary("static_bounded_type<int>: a * b + a", "bounded_type<int>",
+                     &multiply_add_bounded, &make_sample<bounded_sample>,
+                     &make_sample<bounded_sample>),
+         make_binary("static_bounded_type<int>: a * b + a", "static_bounded_type<int>",
+                     &multiply_add_static_bounded, &make_sample<static_bounded_sample>,
+                     &make_sample<static_bounded_sample>),
+         make_unary("clamped_type<int>: make_clamped()", "int", &clamped_raw, &make_value),
+         make_unary("clamped_type<int>: make_clamped()", "clamped_type<int>", &clamped,
+                    &make_value),
+         make_unary("clamped_type<int>: make_clamped()", "clamp(interval, array_ref<int>)",
+                    &clamped_range, &make_value),
+         make_unary("clamped_type<int>: std::vector", "make_clamped() per element",
+                    &clamped_vector, &make_value),
+         make_unary("clamped_type<int>: std::vector", "make_clamped(interval, array_ref)",
+                    &clamped_vector_bulk, &make_value),
+         make_unary("constrained_type<int>: validate", "per element", &check_each,
+                    &make_percent_value),
+         make_unary("constrained_type<int>: validate", "constrain_all()", &check_all,
+                    &make_percent_value),
+         make_unary("constrained_type<int>: validate into std::vector", "per element",
+                    &validate_each, &make_percent_value),
+         make_unary("constrained_type<int>: validate into std::vector", "constrain_all()",
+                    &validate_all, &make_percent_value),
+         make_unary("constrained_type<int>: view buffer", "std::vector<constrained_type<int>>",
+                    &view_vector, &make_percent_value),
+         make_unary("constrained_type<int>: view buffer", "constrained_span<int>", &view_span,
+                    &make_percent_value)};
+} // namespace
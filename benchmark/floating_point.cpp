@@ -0,0 +1,54 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/floating_point.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+#define TYPE_SAFE_BENCHMARK_MAKE_KERNEL(Name, Op)                                                  \
+    template <typename T, typename Raw>                                                            \
+    TYPE_SAFE_BENCHMARK_NOINLINE void Name(const Raw* a, const Raw* b, Raw* out, std::size_t n)    \
+    {                                                                                              \
+        for (std::size_t i = 0u; i != n; ++i)                                                      \
+            out[i] = static_cast<Raw>(T(a[i]) Op T(b[i]));                                         \
+    }
+
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(addition, +)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(multiplication, *)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(division, /)
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_KERNEL
+
+    template <typename Raw>
+    Raw lhs(std::size_t i)
+    {
+        return Raw(i % 100) * Raw(0.5);
+    }
+
+    template <typename Raw>
+    Raw rhs(std::size_t i)
+    {
+        return Raw(1 + i % 97) * Raw(0.25);
+    }
+
+#define TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, Name, Op)                                              \
+    make_binary("floating_point<" #Raw ">: a " #Op " b", #Raw, &Name<Raw, Raw>, &lhs<Raw>,         \
+                &rhs<Raw>),                                                                        \
+        make_binary("floating_point<" #Raw ">: a " #Op " b", "floating_point<" #Raw ">",           \
+                    &Name<ts::floating_point<Raw>, Raw>, &lhs<Raw>, &rhs<Raw>)
+
+    const registrar floating_point_benchmarks = {
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(float, addition, +),
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(float, multiplication, *),
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(double, addition, +),
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(double, multiplication, *),
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(double, division, /)};
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_GROUP
+} // namespace
@@ -0,0 +1,111 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/integer.hpp>
+#include <type_safe/narrow_cast.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+#define TYPE_SAFE_BENCHMARK_MAKE_KERNEL(Name, Op)                                                  \
+    template <typename T, typename Raw>                                                            \
+    TYPE_SAFE_BENCHMARK_NOINLINE void Name(const Raw* a, const Raw* b, Raw* out, std::size_t n)    \
+    {                                                                                              \
+        for (std::size_t i = 0u; i != n; ++i)                                                      \
+            out[i] = static_cast<Raw>(T(a[i]) Op T(b[i]));                                         \
+    }
+
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(addition, +)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(subtraction, -)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(multiplication, *)
+    TYPE_SAFE_BENCHMARK_MAKE_KERNEL(division, /)
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_KERNEL
+
+    // inputs are chosen so that no operation over/underflows
+    template <typename Raw>
+    Raw lhs(std::size_t i)
+    {
+        return Raw(100 + i % 100);
+    }
+
+    template <typename Raw>
+    Raw rhs(std::size_t i)
+    {
+        return Raw(1 + i % 97);
+    }
+
+    template <typename Raw>
+    benchmark make(const std::string& group, std::string name,
+                   binary_kernel<Raw, Raw> kernel)
+    {
+        return make_binary(group, std::move(name), kernel, &lhs<Raw>, &rhs<Raw>);
+    }
+
+#define TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, Name, Op)                                              \
+    make<Raw>("integer<" #Raw ">: a " #Op " b", #Raw, &Name<Raw, Raw>),                            \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "default_arithmetic",                          \
+                  &Name<ts::integer<Raw, ts::default_arithmetic>, Raw>),                           \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "undefined_behavior_arithmetic",               \
+                  &Name<ts::integer<Raw, ts::undefined_behavior_arithmetic>, Raw>),                \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "checked_arithmetic",                          \
+                  &Name<ts::integer<Raw, ts::checked_arithmetic>, Raw>),                           \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "saturating_arithmetic",                       \
+                  &Name<ts::integer<Raw, ts::saturating_arithmetic>, Raw>),                        \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "wrapping_arithmetic",                         \
+                  &Name<ts::integer<Raw, ts::wrapping_arithmetic>, Raw>),                          \
+        make<Raw>("integer<" #Raw ">: a " #Op " b", "sticky_arithmetic",                           \
+                  &Name<ts::integer<Raw, ts::sticky_arithmetic>, Raw>)
+
+#define TYPE_SAFE_BENCHMARK_MAKE_TYPE(Raw)                                                         \
+    TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, addition, +),                                              \
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, subtraction, -),                                       \
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, multiplication, *),                                    \
+        TYPE_SAFE_BENCHMARK_MAKE_GROUP(Raw, division, /)
+
+    const registrar integer_benchmarks = {TYPE_SAFE_BENCHMARK_MAKE_TYPE(short),
+                                          TYPE_SAFE_BENCHMARK_MAKE_TYPE(int),
+                                          TYPE_SAFE_BENCHMARK_MAKE_TYPE(unsigned),
+                                          TYPE_SAFE_BENCHMARK_MAKE_TYPE(long long)};
+
+#undef TYPE_SAFE_BENCHMARK_MAKE_TYPE
+#undef TYPE_SAFE_BENCHMARK_MAKE_GROUP
+
+    //=== widening ===//
+    TYPE_SAFE_BENCHMARK_NOINLINE void average_raw(const int* a, const int* b, int* out,
+                                                  std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<int>((static_cast<long long>(a[i]) + b[i]) / 2);
+    }
+
+    template <class Policy>
+    TYPE_SAFE_BENCHMARK_NOINLINE void average(const int* a, const int* b, int* out, std::size_t n)
+    {
+        using integer = ts::integer<int, Policy>;
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<int>((integer(a[i]) + integer(b[i])) / 2);
+    }
+
+    template <class Policy>
+    TYPE_SAFE_BENCHMARK_NOINLINE void average_widening(const int* a, const int* b, int* out,
+                                                       std::size_t n)
+    {
+        using integer = ts::integer<int, Policy>;
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<int>(
+                ts::narrow_cast<int>(ts::widening_add(integer(a[i]), integer(b[i])) / 2));
+    }
+
+    const registrar widening_benchmarks =
+        {make<int>("integer<int>: (a + b) / 2", "int", &average_raw),
+         make<int>("integer<int>: (a + b) / 2", "checked_arithmetic",
+                   &average<ts::checked_arithmetic>),
+         make<int>("integer<int>: (a + b) / 2", "widening_add()",
+                   &average_widening<ts::default_arithmetic>)};
+} // namespace
@@ -0,0 +1,423 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <new>
+
+#if defined(__linux__)
+#include <elf.h>
+#include <link.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TYPE_SAFE_BENCHMARK_LINUX 1
+#else
+#define TYPE_SAFE_BENCHMARK_LINUX 0
+#endif
+
+namespace
+{
+    std::atomic<std::size_t> allocations(0u);
+} // namespace
+
+namespace type_safe_benchmark
+{
+    std::vector<benchmark>& registry()
+    {
+        static std::vector<benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    std::size_t allocation_count() noexcept
+    {
+        return allocations.load(std::memory_order_relaxed);
+    }
+} // namespace type_safe_benchmark
+
+//=== allocation counter ===//
+// replaces the global allocation functions, all other forms call them
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1u, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0u ? 1u : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+using namespace type_safe_benchmark;
+
+namespace
+{
+    //=== instruction counter ===//
+    // counts retired user-space instructions via perf events, if the kernel allows it
+    class instruction_counter
+    {
+    public:
+        instruction_counter() : fd_(-1)
+        {
+#if TYPE_SAFE_BENCHMARK_LINUX
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof(attr);
+            attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+            attr.disabled       = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        ~instruction_counter()
+        {
+#if TYPE_SAFE_BENCHMARK_LINUX
+            if (fd_ != -1)
+                close(fd_);
+#endif
+        }
+
+        instruction_counter(const instruction_counter&) = delete;
+        instruction_counter& operator=(const instruction_counter&) = delete;
+
+        bool available() const noexcept
+        {
+            return fd_ != -1;
+        }
+
+        void start() noexcept
+        {
+#if TYPE_SAFE_BENCHMARK_LINUX
+            if (fd_ != -1)
+            {
+                ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::uint64_t stop() noexcept
+        {
+            std::uint64_t count = 0u;
+#if TYPE_SAFE_BENCHMARK_LINUX
+            if (fd_ != -1)
+            {
+                ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fd_, &count, sizeof(count)) != sizeof(count))
+                    count = 0u;
+            }
+#endif
+            return count;
+        }
+
+    private:
+        int fd_;
+    };
+
+    //=== symbol table ===//
+    // maps function addresses to their size by reading the symbol table of the executable
+    class symbol_table
+    {
+    public:
+        symbol_table()
+        {
+#if TYPE_SAFE_BENCHMARK_LINUX
+            std::ifstream file("/proc/self/exe", std::ios::binary);
+            std::vector<char> image((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+            if (image.size() < sizeof(ElfW(Ehdr)))
+                return;
+
+            ElfW(Ehdr) header;
+            std::memcpy(&header, image.data(), sizeof(header));
+            if (std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0
+                || header.e_shoff + header.e_shnum * sizeof(ElfW(Shdr)) > image.size())
+                return;
+
+            auto bias = load_bias();
+            for (std::size_t i = 0u; i != header.e_shnum; ++i)
+            {
+                ElfW(Shdr) section;
+                std::memcpy(&section, image.data() + header.e_shoff + i * sizeof(ElfW(Shdr)),
+                            sizeof(section));
+                if (section.sh_type != SHT_SYMTAB
+                    || section.sh_offset + section.sh_size > image.size())
+                    continue;
+
+                for (std::size_t off = 0u; off + sizeof(ElfW(Sym)) <= section.sh_size;
+                     off += sizeof(ElfW(Sym)))
+                {
+                    ElfW(Sym) symbol;
+                    std::memcpy(&symbol, image.data() + section.sh_offset + off, sizeof(symbol));
+                    if (ELF64_ST_TYPE(symbol.st_info) == STT_FUNC && symbol.st_size != 0u)
+                        sizes_.emplace_back(bias + symbol.st_value, symbol.st_size);
+                }
+            }
+            std::sort(sizes_.begin(), sizes_.end());
+#endif
+        }
+
+        // returns 0 if unknown
+        std::size_t size_of(const void* function) const
+        {
+            auto address = reinterpret_cast<std::uintptr_t>(function);
+            auto iter    = std::lower_bound(sizes_.begin(), sizes_.end(),
+                                         std::make_pair(address, std::size_t(0u)));
+            return iter != sizes_.end() && iter->first == address ? iter->second : 0u;
+        }
+
+    private:
+#if TYPE_SAFE_BENCHMARK_LINUX
+        static std::uintptr_t load_bias()
+        {
+            std::uintptr_t result = 0u;
+            // the first object is always the executable itself
+            dl_iterate_phdr(
+                [](dl_phdr_info* info, std::size_t, void* data) {
+                    *static_cast<std::uintptr_t*>(data) = info->dlpi_addr;
+                    return 1;
+                },
+                &result);
+            return result;
+        }
+#endif
+
+        std::vector<std::pair<std::uintptr_t, std::size_t>> sizes_;
+    };
+
+    //=== measurement ===//
+    struct options
+    {
+        double      min_time    = 0.1; // seconds per repetition
+        std::size_t repetitions = 3u;
+        std::string filter;
+        std::string json_file;
+        bool        json = false;
+    };
+
+    struct result
+    {
+        const benchmark* bench;
+        double           ns_per_op;
+        double           instructions_per_op; // negative if unavailable
+        double           allocations_per_op;
+        std::size_t      code_size; // 0 if unavailable
+    };
+
+    result measure(const benchmark& bench, const options& opt, instruction_counter& counter,
+                   const symbol_table& symbols)
+    {
+        using clock = std::chrono::steady_clock;
+
+        // find the number of iterations needed to run at least min_time
+        std::size_t iterations = 1u;
+        while (true)
+        {
+            auto begin = clock::now();
+            bench.run(iterations);
+            std::chrono::duration<double> elapsed = clock::now() - begin;
+            if (elapsed.count() >= opt.min_time || iterations >= std::numeric_limits<std::size_t>::max() / 2u)
+                break;
+            iterations *= 2u;
+        }
+
+        auto best_ns           = -1.0;
+        auto best_instructions = -1.0;
+        auto best_allocations  = -1.0;
+        for (std::size_t rep = 0u; rep != opt.repetitions; ++rep)
+        {
+            auto allocations_begin = allocation_count();
+            counter.start();
+            auto begin = clock::now();
+            bench.run(iterations);
+            auto end          = clock::now();
+            auto instructions = counter.stop();
+            auto allocations  = allocation_count() - allocations_begin;
+
+            auto ops = double(iterations) * double(bench.ops_per_iteration);
+            auto ns  = std::chrono::duration<double, std::nano>(end - begin).count() / ops;
+            if (best_ns < 0.0 || ns < best_ns)
+                best_ns = ns;
+            auto instructions_per_op = double(instructions) / ops;
+            if (counter.available()
+                && (best_instructions < 0.0 || instructions_per_op < best_instructions))
+                best_instructions = instructions_per_op;
+            auto allocations_per_op = double(allocations) / ops;
+            if (best_allocations < 0.0 || allocations_per_op < best_allocations)
+                best_allocations = allocations_per_op;
+        }
+
+        return {&bench, best_ns, best_instructions, best_allocations,
+                symbols.size_of(bench.kernel)};
+    }
+
+    //=== output ===//
+    void print_table(std::ostream& out, const std::vector<result>& results)
+    {
+        char buffer[256];
+        const result* baseline = nullptr;
+        for (auto& res : results)
+        {
+            if (!baseline || baseline->bench->group != res.bench->group)
+            {
+                baseline = &res;
+                out << '\n' << res.bench->group << '\n';
+                std::snprintf(buffer, sizeof(buffer), "  %-40s %10s %10s %12s %10s %10s\n",
+                              "type", "ns/op", "x baseline", "instr/op", "allocs/op",
+                              "code bytes");
+                out << buffer;
+            }
+
+            char instructions[32] = "n/a";
+            if (res.instructions_per_op >= 0.0)
+                std::snprintf(instructions, sizeof(instructions), "%.2f",
+                              res.instructions_per_op);
+            char code_size[32] = "n/a";
+            if (res.code_size != 0u)
+                std::snprintf(code_size, sizeof(code_size), "%zu", res.code_size);
+
+            std::snprintf(buffer, sizeof(buffer), "  %-40s %10.3f %10.2f %12s %10.2f %10s\n",
+                          res.bench->name.c_str(), res.ns_per_op,
+                          res.ns_per_op / baseline->ns_per_op, instructions,
+                          res.allocations_per_op, code_size);
+            out << buffer;
+        }
+    }
+
+    std::string json_string(const std::string& str)
+    {
+        std::string result = "\"";
+        for (auto c : str)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result + '"';
+    }
+
+    void print_json(std::ostream& out, const std::vector<result>& results)
+    {
+        out << "{\n  \"benchmarks\": [";
+        auto first = true;
+        for (auto& res : results)
+        {
+            out << (first ? "\n" : ",\n");
+            first = false;
+
+            out << "    {\"group\": " << json_string(res.bench->group)
+                << ", \"name\": " << json_string(res.bench->name)
+                << ", \"ns_per_op\": " << res.ns_per_op << ", \"instructions_per_op\": ";
+            if (res.instructions_per_op >= 0.0)
+                out << res.instructions_per_op;
+            else
+                out << "null";
+            out << ", \"allocations_per_op\": " << res.allocations_per_op;
+            out << ", \"code_size\": ";
+            if (res.code_size != 0u)
+                out << res.code_size;
+            else
+                out << "null";
+            out << '}';
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void print_usage(const char* exe)
+    {
+        std::cerr << "usage: " << exe << " [options]\n"
+                  << "  --filter <str>      only run benchmarks whose group or name contain str\n"
+                  << "  --min-time <sec>    minimal duration of each repetition (default 0.1)\n"
+                  << "  --repetitions <n>   number of repetitions, the best is reported (default 3)\n"
+                  << "  --json [file]       write results as JSON to file or stdout\n";
+    }
+
+    bool parse_options(int argc, char* argv[], options& opt)
+    {
+        for (auto i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto has_next   = i + 1 < argc && argv[i + 1][0] != '-';
+            if (arg == "--filter" && has_next)
+                opt.filter = argv[++i];
+            else if (arg == "--min-time" && has_next)
+                opt.min_time = std::atof(argv[++i]);
+            else if (arg == "--repetitions" && has_next)
+                opt.repetitions = std::max(std::size_t(1u), std::size_t(std::atoi(argv[++i])));
+            else if (arg == "--json")
+            {
+                opt.json = true;
+                if (has_next)
+                    opt.json_file = argv[++i];
+            }
+            else
+                return false;
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    options opt;
+    if (!parse_options(argc, argv, opt))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto& benchmarks = registry();
+    std::stable_sort(benchmarks.begin(), benchmarks.end(),
+                     [](const benchmark& a, const benchmark& b) { return a.group < b.group; });
+
+    instruction_counter counter;
+    symbol_table        symbols;
+
+    std::vector<result> results;
+    for (auto& bench : benchmarks)
+    {
+        if (!opt.filter.empty() && bench.group.find(opt.filter) == std::string::npos
+            && bench.name.find(opt.filter) == std::string::npos)
+            continue;
+        results.push_back(measure(bench, opt, counter, symbols));
+    }
+
+    // when writing JSON to stdout, don't mix it with the table
+    if (!opt.json || !opt.json_file.empty())
+        print_table(std::cout, results);
+
+    if (opt.json && opt.json_file.empty())
+        print_json(std::cout, results);
+    else if (opt.json)
+    {
+        std::ofstream file(opt.json_file);
+        if (!file)
+        {
+            std::cerr << "unable to open '" << opt.json_file << "'\n";
+            return EXIT_FAILURE;
+        }
+        print_json(file, results);
+    }
+}
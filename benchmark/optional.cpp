@@ -0,0 +1,481 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <type_safe/optional.hpp>
+#include <type_safe/optional_pipeline.hpp>
+#include <type_safe/optional_vector.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    // what one would write without an optional type
+    struct nullable_int
+    {
+        int  value;
+        bool has_value;
+    };
+
+    bool is_present(std::size_t i)
+    {
+        return (i * 2654435761u >> 7) % 4u != 0u;
+    }
+
+    //=== optional<int> ===//
+    nullable_int make_nullable(std::size_t i)
+    {
+        return {int(i), is_present(i)};
+    }
+
+    ts::optional<int> make_opt(std::size_t i)
+    {
+        return is_present(i) ? ts::make_optional(int(i)) : ts::nullopt;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void value_or_raw(const nullable_int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].has_value ? a[i].value : -1;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void value_or_opt(const ts::optional<int>* a, int* out,
+                                                   std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].value_or(-1);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void map_raw(const nullable_int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].has_value ? a[i].value * 2 + 1 : -1;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void map_opt(const ts::optional<int>* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].map([](int v) { return v * 2 + 1; }).value_or(-1);
+    }
+
+    //=== apply() ===//
+    // missing values in runs of 256 elements
+    bool is_present_clustered(std::size_t i)
+    {
+        return (i / 256u) % 4u != 0u;
+    }
+
+    // the rhs column is shifted, so the missing values of both columns only overlap partially
+    template <bool (*Present)(std::size_t), std::size_t Offset>
+    nullable_int make_nullable_column(std::size_t i)
+    {
+        return {int(i), Present(i + Offset)};
+    }
+
+    template <bool (*Present)(std::size_t), std::size_t Offset>
+    ts::optional<int> make_opt_column(std::size_t i)
+    {
+        return Present(i + Offset) ? ts::make_optional(int(i)) : ts::nullopt;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void apply_raw(const nullable_int* a, const nullable_int* b,
+                                                nullable_int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = {a[i].value + b[i].value, a[i].has_value && b[i].has_value};
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void apply_opt(const ts::optional<int>* a,
+                                                const ts::optional<int>* b,
+                                                ts::optional<int>* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = ts::apply<ts::optional<int>>(std::plus<int>{}, a[i], b[i]);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void apply_vector(const ts::optional_vector<int>* a,
+                                                   const ts::optional_vector<int>* b,
+                                                   ts::optional_vector<int>* out, std::size_t)
+    {
+        *out = ts::apply(std::plus<int>{}, *a, *b);
+    }
+
+    template <bool (*Present)(std::size_t), std::size_t Offset>
+    benchmark make_vector_binary(const std::string& group, const std::string& name,
+                                 binary_kernel<ts::optional_vector<int>, ts::optional_vector<int>>
+                                     kernel)
+    {
+        auto make_column = [](std::size_t offset) {
+            auto result = std::make_shared<ts::optional_vector<int>>();
+            for (std::size_t i = 0u; i != block_size; ++i)
+            {
+                if (Present(i + offset))
+                    result->push_back(int(i));
+                else
+                    result->push_back(ts::nullopt);
+            }
+            return result;
+        };
+
+        auto a   = make_column(0u);
+        auto b   = make_column(Offset);
+        auto out = std::make_shared<ts::optional_vector<int>>();
+        return {group, name, address_of(kernel), block_size, [=](std::size_t iterations) {
+                    for (std::size_t i = 0u; i != iterations; ++i)
+                    {
+                        kernel(a.get(), b.get(), out.get(), block_size);
+                        do_not_optimize(*out);
+                    }
+                }};
+    }
+
+    //=== polymorphic ===//
+    struct message
+    {
+        virtual ~message() = default;
+
+        virtual int handle() const = 0;
+    };
+
+    struct ping : message
+    {
+        int id;
+
+        explicit ping(int i) : id(i)
+        {
+        }
+
+        int handle() const override
+        {
+            return id;
+        }
+    };
+
+    struct data : message
+    {
+        int payload[4];
+
+        explicit data(int i) : payload{i, i + 1, i + 2, i + 3}
+        {
+        }
+
+        int handle() const override
+        {
+            return payload[0] + payload[3];
+        }
+    };
+
+    int make_id(std::size_t i)
+    {
+        return int(i);
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void dispatch_unique_ptr(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            ts::optional<std::unique_ptr<message>> msg;
+            if (a[i] % 2 == 0)
+                msg = std::unique_ptr<message>(new ping(a[i]));
+            else
+                msg = std::unique_ptr<message>(new data(a[i]));
+            out[i] = msg.value()->handle();
+        }
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void dispatch_polymorphic(const int* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+        {
+            ts::polymorphic_optional<message, sizeof(data)> msg;
+            if (a[i] % 2 == 0)
+                msg = ping(a[i]);
+            else
+                msg = data(a[i]);
+            out[i] = msg.value().handle();
+        }
+    }
+
+    //=== optional<std::string> ===//
+    ts::optional<std::string> make_string_opt(std::size_t i)
+    {
+        return is_present(i) ? ts::make_optional(std::string(i % 16u, 'a')) : ts::nullopt;
+    }
+
+    std::string greet(const std::string& name)
+    {
+        return "Hello " + name;
+    }
+
+    std::string exclaim(std::string str)
+    {
+        str += '!';
+        return str;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void chained_map(const ts::optional<std::string>* a,
+                                                  std::size_t* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].map(greet).map(exclaim).value_or("").size();
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void pipeline_map(const ts::optional<std::string>* a,
+                                                   std::size_t* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = (a[i] | ts::pipeline::map(greet) | ts::pipeline::map(exclaim)
+                      | ts::pipeline::value_or(""))
+                         .size();
+    }
+
+    //=== copying ===//
+    TYPE_SAFE_BENCHMARK_NOINLINE int value_or_by_value(nullable_int a)
+    {
+        return a.has_value ? a.value : -1;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE int value_or_by_value(ts::optional<int> a)
+    {
+        return a.value_or(-1);
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void pass_by_value(const T* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = value_or_by_value(a[i]);
+    }
+
+    // without reserve(), so the elements are copied on every reallocation
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void vector_growth(const T* a, std::size_t* out, std::size_t n)
+    {
+        std::vector<T> vec;
+        for (std::size_t i = 0u; i != n; ++i)
+            vec.push_back(a[i]);
+        *out = vec.size();
+    }
+
+    //=== optional_ref<int> ===//
+    int values[block_size];
+
+    const int* make_pointer(std::size_t i)
+    {
+        return is_present(i) ? &values[i] : nullptr;
+    }
+
+    ts::optional_ref<const int> make_ref(std::size_t i)
+    {
+        return ts::cref(make_pointer(i));
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void deref_raw(const int* const* a, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i] ? *a[i] : -1;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void deref_ref(const ts::optional_ref<const int>* a, int* out,
+                                                std::size_t n)
+    {
+        static const int fallback = -1;
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = a[i].value_or(fallback);
+    }
+
+    //=== memory ===//
+    // the optionals do not fit into the cache, so the time is dominated by their size
+    constexpr std::size_t large_size = 10000000u;
+
+    template <typename T>
+    struct nullable
+    {
+        T    value;
+        bool has_value;
+    };
+
+    template <typename T>
+    using int_sentinel_opt = ts::sentinel_optional<T, ts::value_sentinel<T, -1>>;
+
+    template <typename T>
+    using nan_sentinel_opt = ts::sentinel_optional<T, ts::nan_sentinel<T>>;
+
+    template <typename T>
+    nullable<T> make_large_nullable(std::size_t i)
+    {
+        return {T(i % 1000u), is_present(i)};
+    }
+
+    template <class Optional, typename T>
+    Optional make_large_opt(std::size_t i)
+    {
+        return is_present(i) ? Optional(T(i % 1000u)) : Optional(ts::nullopt);
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void sum_raw(const nullable<T>* a, T* out, std::size_t n)
+    {
+        T sum(0);
+        for (std::size_t i = 0u; i != n; ++i)
+            sum += a[i].has_value ? a[i].value : T(0);
+        *out = sum;
+    }
+
+    template <class Optional, typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void sum_opt(const Optional* a, T* out, std::size_t n)
+    {
+        T sum(0);
+        for (std::size_t i = 0u; i != n; ++i)
+            sum += a[i].value_or(T(0));
+        *out = sum;
+    }
+
+    // the data is only created when the benchmark is run
+    template <typename In, typename Out, class Generator>
+    benchmark make_large(const std::string& group, const std::string& name,
+                         unary_kernel<In, Out> kernel, Generator gen)
+    {
+        auto data = std::make_shared<std::vector<In>>();
+        return {group, name + ", " + std::to_string(sizeof(In)) + " bytes", address_of(kernel),
+                large_size, [=](std::size_t iterations) {
+                    if (data->empty())
+                    {
+                        data->reserve(large_size);
+                        for (std::size_t i = 0u; i != large_size; ++i)
+                            data->push_back(gen(i));
+                    }
+
+                    Out out;
+                    for (std::size_t i = 0u; i != iterations; ++i)
+                    {
+                        kernel(data->data(), &out, large_size);
+                        do_not_optimize(out);
+                    }
+                }};
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void count_raw(const nullable<T>* a, std::size_t* out,
+                                                std::size_t n)
+    {
+        std::size_t count = 0u;
+        for (std::size_t i = 0u; i != n; ++i)
+            count += a[i].has_value;
+        *out = count;
+    }
+
+    template <class Optional>
+    TYPE_SAFE_BENCHMARK_NOINLINE void count_opt(const Optional* a, std::size_t* out,
+                                                std::size_t n)
+    {
+        std::size_t count = 0u;
+        for (std::size_t i = 0u; i != n; ++i)
+            count += a[i].has_value();
+        *out = count;
+    }
+
+    TYPE_SAFE_BENCHMARK_NOINLINE void count_vector(const ts::optional_vector<int>* a,
+                                                   std::size_t* out, std::size_t)
+    {
+        *out = a->count_present();
+    }
+
+    // the data is only created when the benchmark is run
+    benchmark make_large_vector(const std::string& group, const std::string& name,
+                                unary_kernel<ts::optional_vector<int>, std::size_t> kernel)
+    {
+        auto data = std::make_shared<ts::optional_vector<int>>();
+        return {group, name, address_of(kernel), large_size, [=](std::size_t iterations) {
+                    if (data->empty())
+                    {
+                        data->reserve(large_size);
+                        for (std::size_t i = 0u; i != large_size; ++i)
+                        {
+                            if (is_present(i))
+                                data->push_back(int(i % 1000u));
+                            else
+                                data->push_back(ts::nullopt);
+                        }
+                    }
+
+                    std::size_t out;
+                    for (std::size_t i = 0u; i != iterations; ++i)
+                    {
+                        kernel(data.get(), &out, large_size);
+                        do_not_optimize(out);
+                    }
+                }};
+    }
+
+    const registrar optional_vector_benchmarks =
+        {make_large("10M optional<int>: count present", "int + bool", &count_raw<int>,
+                    &make_large_nullable<int>),
+         make_large("10M optional<int>: count present", "optional<int>",
+                    &count_opt<ts::optional<int>>, &make_large_opt<ts::optional<int>, int>),
+         make_large_vector("10M optional<int>: count present", "optional_vector<int>",
+                           &count_vector)};
+
+    const registrar memory_benchmarks =
+        {make_large("10M optional<int>: sum of value_or()", "int + bool", &sum_raw<int>,
+                    &make_large_nullable<int>),
+         make_large("10M optional<int>: sum of value_or()", "optional<int>",
+                    &sum_opt<ts::optional<int>, int>, &make_large_opt<ts::optional<int>, int>),
+         make_large("10M optional<int>: sum of value_or()", "sentinel_optional<int>",
+                    &sum_opt<int_sentinel_opt<int>, int>,
+                    &make_large_opt<int_sentinel_opt<int>, int>),
+         make_large("10M optional<double>: sum of value_or()", "double + bool",
+                    &sum_raw<double>, &make_large_nullable<double>),
+         make_large("10M optional<double>: sum of value_or()", "optional<double>",
+                    &sum_opt<ts::optional<double>, double>,
+                    &make_large_opt<ts::optional<double>, double>),
+         make_large("10M optional<double>: sum of value_or()", "sentinel_optional<double>",
+                    &sum_opt<nan_sentinel_opt<double>, double>,
+                    &make_large_opt<nan_sentinel_opt<double>, double>)};
+
+    const registrar optional_benchmarks =
+        {make_unary("optional<int>: value_or()", "int + bool", &value_or_raw, &make_nullable),
+         make_unary("optional<int>: value_or()", "optional<int>", &value_or_opt, &make_opt),
+         make_unary("optional<int>: map().value_or()", "int + bool", &map_raw, &make_nullable),
+         make_unary("optional<int>: map().value_or()", "optional<int>", &map_opt, &make_opt),
+         make_binary("optional<int>: apply(a + b)", "int + bool", &apply_raw,
+                     &make_nullable_column<is_present, 0u>, &make_nullable_column<is_present, 7u>),
+         make_binary("optional<int>: apply(a + b)", "optional<int>", &apply_opt,
+                     &make_opt_column<is_present, 0u>, &make_opt_column<is_present, 7u>),
+         make_vector_binary<is_present, 7u>("optional<int>: apply(a + b)", "optional_vector<int>",
+                                            &apply_vector),
+         make_binary("optional<int>: apply(a + b), clustered", "int + bool", &apply_raw,
+                     &make_nullable_column<is_present_clustered, 0u>,
+                     &make_nullable_column<is_present_clustered, 128u>),
+         make_binary("optional<int>: apply(a + b), clustered", "optional<int>", &apply_opt,
+                     &make_opt_column<is_present_clustered, 0u>,
+                     &make_opt_column<is_present_clustered, 128u>),
+         make_vector_binary<is_present_clustered, 128u>("optional<int>: apply(a + b), clustered",
+                                                        "optional_vector<int>", &apply_vector),
+         make_unary("optional<message>: create and dispatch", "optional<unique_ptr<message>>",
+                    &dispatch_unique_ptr, &make_id),
+         make_unary("optional<message>: create and dispatch", "polymorphic_optional<message>",
+                    &dispatch_polymorphic, &make_id),
+         make_unary("optional<std::string>: map().map().value_or()", "chained map()",
+                    &chained_map, &make_string_opt),
+         make_unary("optional<std::string>: map().map().value_or()", "pipeline",
+                    &pipeline_map, &make_string_opt),
+         make_unary("optional<int>: pass by value", "int + bool", &pass_by_value<nullable_int>,
+                    &make_nullable),
+         make_unary("optional<int>: pass by value", "optional<int>",
+                    &pass_by_value<ts::optional<int>>, &make_opt),
+         make_unary("optional<int>: vector push_back()", "int + bool",
+                    &vector_growth<nullable_int>, &make_nullable),
+         make_unary("optional<int>: vector push_back()", "optional<int>",
+                    &vector_growth<ts::optional<int>>, &make_opt),
+         make_unary("optional_ref<int>: value_or()", "const int*", &deref_raw, &make_pointer),
+         make_unary("optional_ref<int>: value_or()", "optional_ref<const int>", &deref_ref,
+                    &make_ref)};
+} // namespace
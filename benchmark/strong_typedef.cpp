@@ -0,0 +1,218 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__cpp_lib_string_view)
+#include <string_view>
+#endif
+
+#include <type_safe/hash_cached.hpp>
+#include <type_safe/strong_typedef.hpp>
+
+#include "benchmark.hpp"
+
+namespace ts = type_safe;
+using namespace type_safe_benchmark;
+
+namespace
+{
+    struct user_id : ts::strong_typedef<user_id, std::string>,
+                     ts::strong_typedef_op::equality_comparision<user_id, bool>,
+                     ts::strong_typedef_op::relational_comparision<user_id, bool>
+    {
+        using strong_typedef::strong_typedef;
+    };
+
+    struct cached_user_id : ts::strong_typedef<cached_user_id, ts::hash_cached<std::string>>,
+                            ts::strong_typedef_op::equality_comparision<cached_user_id, bool>
+    {
+        explicit cached_user_id(std::string name)
+        : strong_typedef(ts::hash_cached<std::string>(std::move(name)))
+        {
+        }
+    };
+} // namespace
+
+namespace std
+{
+    template <>
+    struct hash<user_id> : ts::hashable<user_id>
+    {
+    };
+
+    template <>
+    struct hash<cached_user_id> : ts::hashable<cached_user_id>
+    {
+    };
+} // namespace std
+
+namespace
+{
+    struct distance : ts::strong_typedef<distance, int>,
+                      ts::strong_typedef_op::integer_arithmetic<distance>,
+                      ts::strong_typedef_op::relational_comparision<distance, bool>
+    {
+        using strong_typedef::strong_typedef;
+    };
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void addition(const int* a, const int* b, int* out,
+                                               std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<const int&>(T(a[i]) + T(b[i]));
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void multiplication(const int* a, const int* b, int* out,
+                                                     std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = static_cast<const int&>(T(a[i]) * T(b[i]));
+    }
+
+    template <typename T>
+    TYPE_SAFE_BENCHMARK_NOINLINE void max(const int* a, const int* b, int* out, std::size_t n)
+    {
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = T(a[i]) < T(b[i]) ? b[i] : a[i];
+    }
+
+    int lhs(std::size_t i)
+    {
+        return int(i % 100);
+    }
+
+    int rhs(std::size_t i)
+    {
+        return int(1 + i % 97);
+    }
+
+    //=== unordered_map lookup ===//
+    constexpr std::size_t user_count = 1000u;
+
+    std::string make_name(std::size_t i)
+    {
+        return "user-" + std::string(32u, 'x') + std::to_string(i % user_count);
+    }
+
+    template <typename Key>
+    Key make_key(std::size_t i)
+    {
+        return Key(make_name(i));
+    }
+
+    template <typename Key>
+    const std::unordered_map<Key, int>& user_map()
+    {
+        static const auto map = [] {
+            std::unordered_map<Key, int> result;
+            for (std::size_t i = 0u; i != user_count; ++i)
+                result.emplace(make_key<Key>(i), int(i));
+            return result;
+        }();
+        return map;
+    }
+
+    template <typename Key>
+    TYPE_SAFE_BENCHMARK_NOINLINE void lookup(const Key* keys, int* out, std::size_t n)
+    {
+        auto& map = user_map<Key>();
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = map.find(keys[i])->second;
+    }
+
+    const registrar lookup_benchmarks =
+        {make_unary("unordered_map<strong_typedef<std::string>>: find()", "std::string",
+                    &lookup<std::string>, &make_key<std::string>),
+         make_unary("unordered_map<strong_typedef<std::string>>: find()", "hashable",
+                    &lookup<user_id>, &make_key<user_id>),
+         make_unary("unordered_map<strong_typedef<std::string>>: find()", "hash_cached",
+                    &lookup<cached_user_id>, &make_key<cached_user_id>)};
+
+    //=== heterogeneous lookup ===//
+#if defined(__cpp_lib_string_view)
+    std::string_view make_name_view(std::size_t i)
+    {
+        static const auto names = [] {
+            std::vector<std::string> result;
+            for (std::size_t i = 0u; i != user_count; ++i)
+                result.push_back(make_name(i));
+            return result;
+        }();
+        return names[i % user_count];
+    }
+
+    template <class Map>
+    const Map& named_user_map()
+    {
+        static const auto map = [] {
+            Map result;
+            for (std::size_t i = 0u; i != user_count; ++i)
+                result.emplace(make_key<user_id>(i), int(i));
+            return result;
+        }();
+        return map;
+    }
+
+    // creates a user_id and thus a std::string for every lookup
+    template <class Map>
+    TYPE_SAFE_BENCHMARK_NOINLINE void lookup_temporary(const std::string_view* names, int* out,
+                                                       std::size_t n)
+    {
+        auto& map = named_user_map<Map>();
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = map.find(user_id(std::string(names[i])))->second;
+    }
+
+    template <class Map>
+    TYPE_SAFE_BENCHMARK_NOINLINE void lookup_transparent(const std::string_view* names, int* out,
+                                                         std::size_t n)
+    {
+        auto& map = named_user_map<Map>();
+        for (std::size_t i = 0u; i != n; ++i)
+            out[i] = map.find(names[i])->second;
+    }
+
+    using transparent_map =
+        std::map<user_id, int, ts::strong_typedef_op::transparent_less<user_id>>;
+
+    const registrar map_lookup_benchmarks =
+        {make_unary("map<strong_typedef<std::string>>: find(std::string_view)", "temporary key",
+                    &lookup_temporary<std::map<user_id, int>>, &make_name_view),
+         make_unary("map<strong_typedef<std::string>>: find(std::string_view)",
+                    "transparent_less", &lookup_transparent<transparent_map>, &make_name_view)};
+
+#if defined(__cpp_lib_generic_unordered_lookup)
+    using transparent_unordered_map =
+        std::unordered_map<user_id, int,
+                           ts::strong_typedef_op::transparent_hash<user_id,
+                                                                   std::hash<std::string_view>>,
+                           ts::strong_typedef_op::transparent_equal<user_id>>;
+
+    const registrar unordered_map_lookup_benchmarks =
+        {make_unary("unordered_map<strong_typedef<std::string>>: find(std::string_view)",
+                    "temporary key", &lookup_temporary<std::unordered_map<user_id, int>>,
+                    &make_name_view),
+         make_unary("unordered_map<strong_typedef<std::string>>: find(std::string_view)",
+                    "transparent_hash", &lookup_transparent<transparent_unordered_map>,
+                    &make_name_view)};
+#endif
+#endif
+
+    const registrar strong_typedef_benchmarks =
+        {make_binary("strong_typedef<int>: a + b", "int", &addition<int>, &lhs, &rhs),
+         make_binary("strong_typedef<int>: a + b", "strong_typedef<int>", &addition<distance>,
+                     &lhs, &rhs),
+         make_binary("strong_typedef<int>: a * b", "int", &multiplication<int>, &lhs, &rhs),
+         make_binary("strong_typedef<int>: a * b", "strong_typedef<int>",
+                     &multiplication<distance>, &lhs, &rhs),
+         make_binary("strong_typedef<int>: a < b", "int", &max<int>, &lhs, &rhs),
+         make_binary("strong_typedef<int>: a < b", "strong_typedef<int>", &max<distance>, &lhs,
+                     &rhs)};
+} // namespace
@@ -16,6 +16,34 @@
 #define TYPE_SAFE_ARITHMETIC_UB 1
 #endif
 
+// GCC: __builtin_*_overflow_p() can be used in C++11 constexpr functions
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 7
+#define TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_P 1
+#else
+#define TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_P 0
+#endif
+
+// clang: __builtin_*_overflow() requires a local variable, i.e. C++14 constexpr,
+// and is only usable in constant expressions since clang 7
+#if defined(__clang__) && defined(__has_builtin) && defined(__cpp_constexpr)
+#if __has_builtin(__builtin_add_overflow) && __cpp_constexpr >= 201304                             \
+    && ((defined(__apple_build_version__) && __clang_major__ >= 11)                                \
+        || (!defined(__apple_build_version__) && __clang_major__ >= 7))
+#define TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL 1
+#endif
+#endif
+#ifndef TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL
+#define TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL 0
+#endif
+
+#ifndef TYPE_SAFE_ARITHMETIC_BUILTIN
+#if TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_P || TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL
+#define TYPE_SAFE_ARITHMETIC_BUILTIN 1
+#else
+#define TYPE_SAFE_ARITHMETIC_BUILTIN 0
+#endif
+#endif
+
 namespace type_safe
 {
     /// An `ArithmeticPolicy` that behaves like the default integer implementations:
@@ -65,10 +93,31 @@ namespace type_safe
         };
 
         template <typename T>
-        using arithmetic_tag_for =
+        using integer_tag_for =
             typename std::conditional<std::is_signed<T>::value, signed_integer_tag,
                                       unsigned_integer_tag>::type;
 
+#if TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_P || TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL
+#define TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG 1
+        // uses the overflow builtins of the compiler,
+        // they compile to the arithmetic instruction followed by a check of the overflow flag
+        struct builtin_integer_tag
+        {
+        };
+#else
+#define TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG 0
+#endif
+
+        // the tag the arithmetic policies use,
+        // requesting the builtins falls back to the portable checks if they are not available
+        template <typename T>
+        using arithmetic_tag_for =
+#if TYPE_SAFE_ARITHMETIC_BUILTIN && TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+            builtin_integer_tag;
+#else
+            integer_tag_for<T>;
+#endif
+
         template <typename T>
         constexpr bool will_addition_error(signed_integer_tag, const T& a, const T& b)
         {
@@ -128,6 +177,319 @@ namespace type_safe
         {
             return b == T(0);
         }
+
+#if TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_P
+        template <typename T>
+        constexpr bool will_addition_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            return __builtin_add_overflow_p(a, b, T(0));
+        }
+
+        template <typename T>
+        constexpr bool will_subtraction_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            return __builtin_sub_overflow_p(a, b, T(0));
+        }
+
+        template <typename T>
+        constexpr bool will_multiplication_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            return __builtin_mul_overflow_p(a, b, T(0));
+        }
+#elif TYPE_SAFE_DETAIL_ARITHMETIC_BUILTIN_LOCAL
+        template <typename T>
+        constexpr bool will_addition_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            T result{};
+            return __builtin_add_overflow(a, b, &result);
+        }
+
+        template <typename T>
+        constexpr bool will_subtraction_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            T result{};
+            return __builtin_sub_overflow(a, b, &result);
+        }
+
+        template <typename T>
+        constexpr bool will_multiplication_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            T result{};
+            return __builtin_mul_overflow(a, b, &result);
+        }
+#endif
+
+#if TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+        // there are no builtins for division, the portable checks are cheap anyway
+        template <typename T>
+        constexpr bool will_division_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            return will_division_error(integer_tag_for<T>{}, a, b);
+        }
+
+        template <typename T>
+        constexpr bool will_modulo_error(builtin_integer_tag, const T& a, const T& b)
+        {
+            return will_modulo_error(integer_tag_for<T>{}, a, b);
+        }
+#endif
+
+        //=== wrapping arithmetic ===//
+        // computes the result modulo 2^N, without undefined behavior or branches,
+        // and reports whether it differs from the mathematical result,
+        // this is used for loops the compiler should vectorize
+
+        // the unsigned type the operation is performed in, avoiding integral promotion to int
+        template <typename T>
+        using wrapping_type =
+            typename std::conditional<sizeof(T) < sizeof(unsigned), unsigned,
+                                      typename std::make_unsigned<T>::type>::type;
+
+        template <typename T>
+        constexpr T wrapping_addition(const T& a, const T& b) noexcept
+        {
+            return static_cast<T>(static_cast<wrapping_type<T>>(a)
+                                  + static_cast<wrapping_type<T>>(b));
+        }
+
+        template <typename T>
+        constexpr T wrapping_subtraction(const T& a, const T& b) noexcept
+        {
+            return static_cast<T>(static_cast<wrapping_type<T>>(a)
+                                  - static_cast<wrapping_type<T>>(b));
+        }
+
+        template <typename T>
+        constexpr T wrapping_multiplication(const T& a, const T& b) noexcept
+        {
+            return static_cast<T>(static_cast<wrapping_type<T>>(a)
+                                  * static_cast<wrapping_type<T>>(b));
+        }
+
+        // a / b and a % b where min / -1 wraps around to min
+        template <typename T>
+        constexpr T wrapping_division(signed_integer_tag, const T& a, const T& b) noexcept
+        {
+            return b == T(-1) ? wrapping_subtraction(T(0), a) : static_cast<T>(a / b);
+        }
+        template <typename T>
+        constexpr T wrapping_division(unsigned_integer_tag, const T& a, const T& b) noexcept
+        {
+            return static_cast<T>(a / b);
+        }
+
+        template <typename T>
+        constexpr T wrapping_modulo(signed_integer_tag, const T& a, const T& b) noexcept
+        {
+            return b == T(-1) ? T(0) : static_cast<T>(a % b);
+        }
+        template <typename T>
+        constexpr T wrapping_modulo(unsigned_integer_tag, const T& a, const T& b) noexcept
+        {
+            return static_cast<T>(a % b);
+        }
+
+        // whether the wrapped result of a + b differs from the real one
+        template <typename T>
+        constexpr bool did_addition_error(signed_integer_tag, const T& a, const T& b,
+                                          const T& result) noexcept
+        {
+            // overflow iff both operands have the same sign and the result a different one
+            return ((a ^ result) & (b ^ result)) < 0;
+        }
+        template <typename T>
+        constexpr bool did_addition_error(unsigned_integer_tag, const T& a, const T&,
+                                          const T& result) noexcept
+        {
+            return result < a;
+        }
+
+        // whether the wrapped result of a - b differs from the real one
+        template <typename T>
+        constexpr bool did_subtraction_error(signed_integer_tag, const T& a, const T& b,
+                                             const T& result) noexcept
+        {
+            // overflow iff the operands have different signs and the result has the sign of b
+            return ((a ^ b) & (a ^ result)) < 0;
+        }
+        template <typename T>
+        constexpr bool did_subtraction_error(unsigned_integer_tag, const T& a, const T& b,
+                                             const T&) noexcept
+        {
+            return a < b;
+        }
+
+#if TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+        // the builtins use the overflow flag of the CPU,
+        // which is cheaper than the checks above, unless the loop is vectorized
+        template <typename T>
+        constexpr bool did_addition_error(builtin_integer_tag, const T& a, const T& b,
+                                          const T&) noexcept
+        {
+            return will_addition_error(builtin_integer_tag{}, a, b);
+        }
+
+        template <typename T>
+        constexpr bool did_subtraction_error(builtin_integer_tag, const T& a, const T& b,
+                                             const T&) noexcept
+        {
+            return will_subtraction_error(builtin_integer_tag{}, a, b);
+        }
+#endif
+
+        // the product of two T fits into wide_multiplication_type<T>, if there is such a type
+        // (the narrowest such type, so more of them fit into a vector register)
+        template <typename T>
+        using wide_multiplication_type = typename std::conditional<
+            2 * sizeof(T) <= sizeof(int),
+            typename std::conditional<std::is_signed<T>::value, int, unsigned>::type,
+            typename std::conditional<std::is_signed<T>::value, long long,
+                                      unsigned long long>::type>::type;
+
+        template <typename T>
+        using has_wide_multiplication =
+            std::integral_constant<bool, 2 * sizeof(T) <= sizeof(wide_multiplication_type<T>)>;
+
+        template <typename T>
+        constexpr bool did_multiplication_error(std::true_type, const T& a, const T& b) noexcept
+        {
+            return static_cast<wide_multiplication_type<T>>(a)
+                           * static_cast<wide_multiplication_type<T>>(b)
+                       > static_cast<wide_multiplication_type<T>>(std::numeric_limits<T>::max())
+                   || static_cast<wide_multiplication_type<T>>(a)
+                              * static_cast<wide_multiplication_type<T>>(b)
+                          < static_cast<wide_multiplication_type<T>>(
+                                std::numeric_limits<T>::min());
+        }
+        template <typename T>
+        constexpr bool did_multiplication_error(std::false_type, const T& a, const T& b) noexcept
+        {
+            return will_multiplication_error(arithmetic_tag_for<T>{}, a, b);
+        }
+
+        // whether the wrapped result of a * b differs from the real one
+        template <typename T>
+        constexpr bool did_multiplication_error(const T& a, const T& b) noexcept
+        {
+            return did_multiplication_error(has_wide_multiplication<T>{}, a, b);
+        }
+
+        template <typename T>
+        constexpr bool did_multiplication_error(signed_integer_tag, const T& a, const T& b) noexcept
+        {
+            return did_multiplication_error(a, b);
+        }
+        template <typename T>
+        constexpr bool did_multiplication_error(unsigned_integer_tag, const T& a,
+                                                const T& b) noexcept
+        {
+            return did_multiplication_error(a, b);
+        }
+#if TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+        template <typename T>
+        constexpr bool did_multiplication_error(builtin_integer_tag, const T& a,
+                                                const T& b) noexcept
+        {
+            return will_multiplication_error(builtin_integer_tag{}, a, b);
+        }
+#endif
+
+        //=== saturating arithmetic ===//
+        // clamps the result to [min, max] using selects only, so it can be vectorized
+
+        // min if negative, max otherwise, computed as max + 1 to avoid a select
+        template <typename T>
+        constexpr T saturated_value(bool negative) noexcept
+        {
+            return wrapping_addition(std::numeric_limits<T>::max(), static_cast<T>(negative));
+        }
+
+        template <typename T>
+        constexpr T saturating_addition(signed_integer_tag, const T& a, const T& b,
+                                        const T& result) noexcept
+        {
+            // both operands have the same sign on overflow
+            return did_addition_error(signed_integer_tag{}, a, b, result) ?
+                       saturated_value<T>(a < T(0)) :
+                       result;
+        }
+        template <typename T>
+        constexpr T saturating_addition(unsigned_integer_tag, const T& a, const T&,
+                                        const T& result) noexcept
+        {
+            return result < a ? std::numeric_limits<T>::max() : result;
+        }
+
+        template <typename T>
+        constexpr T saturating_addition(const T& a, const T& b) noexcept
+        {
+            return saturating_addition(integer_tag_for<T>{}, a, b, wrapping_addition(a, b));
+        }
+
+        template <typename T>
+        constexpr T saturating_subtraction(signed_integer_tag, const T& a, const T& b,
+                                           const T& result) noexcept
+        {
+            // a has the sign of the real result on over/underflow
+            return did_subtraction_error(signed_integer_tag{}, a, b, result) ?
+                       saturated_value<T>(a < T(0)) :
+                       result;
+        }
+        template <typename T>
+        constexpr T saturating_subtraction(unsigned_integer_tag, const T& a, const T& b,
+                                           const T& result) noexcept
+        {
+            return a < b ? T(0) : result;
+        }
+
+        template <typename T>
+        constexpr T saturating_subtraction(const T& a, const T& b) noexcept
+        {
+            return saturating_subtraction(integer_tag_for<T>{}, a, b, wrapping_subtraction(a, b));
+        }
+
+        template <typename T>
+        constexpr T saturating_narrow(const wide_multiplication_type<T>& value) noexcept
+        {
+            return value > static_cast<wide_multiplication_type<T>>(std::numeric_limits<T>::max()) ?
+                       std::numeric_limits<T>::max() :
+                       (value < static_cast<wide_multiplication_type<T>>(
+                                    std::numeric_limits<T>::min()) ?
+                            std::numeric_limits<T>::min() :
+                            static_cast<T>(value));
+        }
+
+        template <typename T, class Tag>
+        constexpr T saturating_multiplication(std::true_type, Tag, const T& a, const T& b) noexcept
+        {
+            return saturating_narrow<T>(static_cast<wide_multiplication_type<T>>(a)
+                                        * static_cast<wide_multiplication_type<T>>(b));
+        }
+        template <typename T>
+        constexpr T saturating_multiplication(std::false_type, signed_integer_tag, const T& a,
+                                              const T& b) noexcept
+        {
+            return did_multiplication_error(std::false_type{}, a, b) ?
+                       saturated_value<T>((a < T(0)) != (b < T(0))) :
+                       wrapping_multiplication(a, b);
+        }
+        template <typename T>
+        constexpr T saturating_multiplication(std::false_type, unsigned_integer_tag, const T& a,
+                                              const T& b) noexcept
+        {
+            return did_multiplication_error(std::false_type{}, a, b) ?
+                       std::numeric_limits<T>::max() :
+                       wrapping_multiplication(a, b);
+        }
+
+        template <typename T>
+        constexpr T saturating_multiplication(const T& a, const T& b) noexcept
+        {
+            // clamping a 64bit product is slower than checking for overflow
+            return saturating_multiplication(std::integral_constant<bool, 2 * sizeof(T)
+                                                                               <= sizeof(int)>{},
+                                             integer_tag_for<T>{}, a, b);
+        }
     } // namespace detail
 
     /// An `ArithmeticPolicy` where under/overflow is always undefined behavior,
@@ -181,6 +543,12 @@ namespace type_safe
                        (DEBUG_UNREACHABLE(detail::assert_handler{}, "modulo by zero"), a) :
                        a % b;
         }
+
+        /// \effects Reports that an operation on a batch of integers resulted in under/overflow.
+        static void do_batch_error(const char* message) noexcept
+        {
+            DEBUG_UNREACHABLE(detail::assert_handler{}, message);
+        }
     };
 
     /// An `ArithmeticPolicy` where under/overflow throws an exception.
@@ -234,6 +602,223 @@ namespace type_safe
                        throw error("module by zero") :
                        a % b;
         }
+
+        /// \effects Throws an exception as an operation on a batch of integers resulted in under/overflow.
+        static void do_batch_error(const char* message)
+        {
+            throw error(message);
+        }
+    };
+
+    /// An `ArithmeticPolicy` where under/overflow saturates,
+    /// i.e. the result is clamped to the minimum or maximum value of the type.
+    ///
+    /// Addition, subtraction and multiplication are branchless,
+    /// so loops over [type_safe::integer<T, Policy>]() can be vectorized.
+    /// Division by zero is undefined behavior, checked when assertions are enabled.
+    class saturating_arithmetic
+    {
+    public:
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_addition(const T& a, const T& b) noexcept
+        {
+            return detail::saturating_addition(a, b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_subtraction(const T& a, const T& b) noexcept
+        {
+            return detail::saturating_subtraction(a, b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_multiplication(const T& a, const T& b) noexcept
+        {
+            return detail::saturating_multiplication(a, b);
+        }
+
+        /// \notes The only overflowing division, `min / -1`, results in `max`.
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_division(const T& a, const T& b) noexcept
+        {
+            return b == T(0) ?
+                       (DEBUG_UNREACHABLE(detail::assert_handler{}, "division by zero"), a) :
+                       (detail::will_division_error(detail::integer_tag_for<T>{}, a, b) ?
+                            std::numeric_limits<T>::max() :
+                            static_cast<T>(a / b));
+        }
+
+        /// \notes `min % -1` results in `0`.
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_modulo(const T& a, const T& b) noexcept
+        {
+            return b == T(0) ? (DEBUG_UNREACHABLE(detail::assert_handler{}, "modulo by zero"), a) :
+                               (detail::will_division_error(detail::integer_tag_for<T>{}, a, b) ?
+                                    T(0) :
+                                    static_cast<T>(a % b));
+        }
+    };
+
+    /// An `ArithmeticPolicy` where under/overflow wraps around,
+    /// i.e. the result is computed modulo `2^N` - for signed integers as well.
+    ///
+    /// Addition, subtraction and multiplication do not check anything,
+    /// they compile to the plain machine instructions.
+    /// Division by zero is undefined behavior, checked when assertions are enabled.
+    class wrapping_arithmetic
+    {
+    public:
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_addition(const T& a, const T& b) noexcept
+        {
+            return detail::wrapping_addition(a, b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_subtraction(const T& a, const T& b) noexcept
+        {
+            return detail::wrapping_subtraction(a, b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_multiplication(const T& a, const T& b) noexcept
+        {
+            return detail::wrapping_multiplication(a, b);
+        }
+
+        /// \notes The only overflowing division, `min / -1`, results in `min`.
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_division(const T& a, const T& b) noexcept
+        {
+            return b == T(0) ?
+                       (DEBUG_UNREACHABLE(detail::assert_handler{}, "division by zero"), a) :
+                       detail::wrapping_division(detail::integer_tag_for<T>{}, a, b);
+        }
+
+        /// \notes `min % -1` results in `0`.
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static constexpr T do_modulo(const T& a, const T& b) noexcept
+        {
+            return b == T(0) ? (DEBUG_UNREACHABLE(detail::assert_handler{}, "modulo by zero"), a) :
+                               detail::wrapping_modulo(detail::integer_tag_for<T>{}, a, b);
+        }
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        inline bool& sticky_overflow_flag() noexcept
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
+        TYPE_SAFE_FORCE_INLINE void record_overflow(bool error) noexcept
+        {
+            // no branch, the flag is only ever set
+            sticky_overflow_flag() |= error;
+        }
+    } // namespace detail
+
+    /// An `ArithmeticPolicy` where under/overflow is recorded in a sticky, thread-local flag,
+    /// instead of being reported immediately.
+    ///
+    /// The operations never branch:
+    /// they compute the wrapped result and set the flag on over/underflow,
+    /// so a long computation can be checked once at the end using a [type_safe::overflow_scope]().
+    /// Division by zero sets the flag as well and results in the dividend.
+    class sticky_arithmetic
+    {
+    public:
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static T do_addition(const T& a, const T& b) noexcept
+        {
+            auto result = detail::wrapping_addition(a, b);
+            detail::record_overflow(
+                detail::did_addition_error(detail::arithmetic_tag_for<T>{}, a, b, result));
+            return result;
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static T do_subtraction(const T& a, const T& b) noexcept
+        {
+            auto result = detail::wrapping_subtraction(a, b);
+            detail::record_overflow(
+                detail::did_subtraction_error(detail::arithmetic_tag_for<T>{}, a, b, result));
+            return result;
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static T do_multiplication(const T& a, const T& b) noexcept
+        {
+            detail::record_overflow(
+                detail::did_multiplication_error(detail::arithmetic_tag_for<T>{}, a, b));
+            return detail::wrapping_multiplication(a, b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static T do_division(const T& a, const T& b) noexcept
+        {
+            auto error = detail::will_division_error(detail::integer_tag_for<T>{}, a, b);
+            detail::record_overflow(error);
+            return error ? a : static_cast<T>(a / b);
+        }
+
+        template <typename T>
+        TYPE_SAFE_FORCE_INLINE static T do_modulo(const T& a, const T& b) noexcept
+        {
+            auto error = b == T(0);
+            detail::record_overflow(error);
+            return error ? a : detail::wrapping_modulo(detail::integer_tag_for<T>{}, a, b);
+        }
+
+        /// \effects Records that an operation on a batch of integers resulted in under/overflow.
+        static void do_batch_error(const char*) noexcept
+        {
+            detail::record_overflow(true);
+        }
+    };
+
+    /// Checks the under/overflow of the [type_safe::sticky_arithmetic]() operations
+    /// performed by the current thread during its lifetime.
+    ///
+    /// Scopes can be nested, an under/overflow inside the inner scope is an under/overflow
+    /// of the outer scope as well.
+    class overflow_scope
+    {
+    public:
+        /// \effects Starts a new scope without any under/overflow.
+        overflow_scope() noexcept : outer_(detail::sticky_overflow_flag())
+        {
+            detail::sticky_overflow_flag() = false;
+        }
+
+        overflow_scope(const overflow_scope&) = delete;
+        overflow_scope& operator=(const overflow_scope&) = delete;
+
+        /// \effects Restores the state of the outer scope, adding the under/overflow of this one.
+        ~overflow_scope() noexcept
+        {
+            detail::record_overflow(outer_);
+        }
+
+        /// \returns Whether or not an operation under/overflowed since the scope was started.
+        bool overflowed() const noexcept
+        {
+            return detail::sticky_overflow_flag();
+        }
+
+        /// \effects Throws an exception,
+        /// if an operation under/overflowed since the scope was started.
+        /// \throws [type_safe::checked_arithmetic::error]() in that case.
+        void check() const
+        {
+            if (overflowed())
+                throw checked_arithmetic::error("arithmetic operation resulted in under/overflow");
+        }
+
+    private:
+        bool outer_;
     };
 
 #if TYPE_SAFE_ARITHMETIC_UB
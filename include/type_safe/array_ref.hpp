@@ -0,0 +1,177 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ARRAY_REF_HPP_INCLUDED
+#define TYPE_SAFE_ARRAY_REF_HPP_INCLUDED
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/detail/assert.hpp>
+
+namespace type_safe
+{
+    template <typename T>
+    class array_ref;
+
+    /// \exclude
+    namespace detail
+    {
+        template <typename T>
+        struct is_array_ref : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_array_ref<array_ref<T>> : std::true_type
+        {
+        };
+
+        template <class Container, typename T>
+        using enable_contiguous_container = typename std::enable_if<
+            !is_array_ref<typename std::remove_cv<Container>::type>::value
+            && std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value
+            && std::is_convertible<decltype(std::declval<Container&>().size()),
+                                   std::size_t>::value>::type;
+
+        // prevents deduction of T from an argument,
+        // so a function taking an array_ref<T> also accepts containers
+        template <typename T>
+        struct non_deduced
+        {
+            using type = T;
+        };
+
+        template <typename T>
+        using non_deduced_t = typename non_deduced<T>::type;
+    } // namespace detail
+
+    /// A non-owning reference to a contiguous sequence of objects of type `T`.
+    ///
+    /// It is a pointer and a size, like a `span` or `array_view`.
+    /// Use `array_ref<const T>` for read-only access.
+    /// \requires `T` must not be a reference.
+    template <typename T>
+    class array_ref
+    {
+        static_assert(!std::is_reference<T>::value, "T must not be a reference");
+
+    public:
+        using value_type = typename std::remove_cv<T>::type;
+        using iterator   = T*;
+
+        /// \effects Creates it referring to the objects in the range `[begin, end)`.
+        /// \requires `[begin, end)` must be a valid range.
+        array_ref(T* begin, T* end) noexcept
+        : begin_(begin), size_(static_cast<std::size_t>(end - begin))
+        {
+            DEBUG_ASSERT(begin <= end, detail::assert_handler{}, "invalid range");
+        }
+
+        /// \effects Creates it referring to the `size` objects starting at `data`.
+        /// \requires `data` must point to at least `size` objects.
+        array_ref(T* data, std::size_t size) noexcept : begin_(data), size_(size)
+        {
+            DEBUG_ASSERT(data || size == 0u, detail::assert_handler{}, "invalid range");
+        }
+
+        /// \effects Creates it referring to all objects of the array.
+        template <std::size_t N>
+        array_ref(T (&array)[N]) noexcept : begin_(array), size_(N)
+        {
+        }
+
+        /// \effects Creates it referring to the objects of a contiguous container,
+        /// i.e. `[c.data(), c.data() + c.size())`.
+        /// \notes This constructor does not participate in overload resolution,
+        /// unless `c.data()` is convertible to `T*`.
+        template <class Container, typename = detail::enable_contiguous_container<Container, T>>
+        array_ref(Container& c) noexcept(noexcept(c.data()) && noexcept(c.size()))
+        : array_ref(c.data(), static_cast<std::size_t>(c.size()))
+        {
+        }
+
+        /// \effects Creates a reference to `const` from a reference to non-`const`.
+        template <typename U,
+                  typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        array_ref(const array_ref<U>& other) noexcept : begin_(other.data()), size_(other.size())
+        {
+        }
+
+        /// \returns An iterator to the first object.
+        iterator begin() const noexcept
+        {
+            return begin_;
+        }
+
+        /// \returns An iterator one past the last object.
+        iterator end() const noexcept
+        {
+            return begin_ + size_;
+        }
+
+        /// \returns A pointer to the first object.
+        T* data() const noexcept
+        {
+            return begin_;
+        }
+
+        /// \returns The number of objects.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not it refers to no objects.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns A reference to the `i`th object.
+        /// \requires `i < size()`.
+        T& operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::assert_handler{}, "out of bounds");
+            return begin_[i];
+        }
+
+        /// \returns A reference to the objects `[begin() + first, begin() + first + count)`.
+        /// \requires `first + count <= size()`.
+        array_ref subrange(std::size_t first, std::size_t count) const noexcept
+        {
+            DEBUG_ASSERT(first + count <= size_, detail::assert_handler{}, "out of bounds");
+            return array_ref(begin_ + first, count);
+        }
+
+    private:
+        T*          begin_;
+        std::size_t size_;
+    };
+
+    /// \returns An [type_safe::array_ref<T>]() referring to the `size` objects starting at `data`.
+    template <typename T>
+    array_ref<T> make_array_ref(T* data, std::size_t size) noexcept
+    {
+        return array_ref<T>(data, size);
+    }
+
+    /// \returns An [type_safe::array_ref<T>]() referring to all objects of the array.
+    template <typename T, std::size_t N>
+    array_ref<T> make_array_ref(T (&array)[N]) noexcept
+    {
+        return array_ref<T>(array);
+    }
+
+    /// \returns An [type_safe::array_ref<T>]() referring to all objects of the contiguous container.
+    template <class Container>
+    auto make_array_ref(Container& c) noexcept
+        -> array_ref<typename std::remove_pointer<decltype(c.data())>::type>
+    {
+        return {c.data(), static_cast<std::size_t>(c.size())};
+    }
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ARRAY_REF_HPP_INCLUDED
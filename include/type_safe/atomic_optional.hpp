@@ -0,0 +1,168 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_ATOMIC_OPTIONAL_HPP_INCLUDED
+#define TYPE_SAFE_ATOMIC_OPTIONAL_HPP_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <type_safe/optional.hpp>
+
+namespace type_safe
+{
+    /// \exclude
+    namespace detail
+    {
+        // smallest unsigned integer with room for the value and one byte for the presence
+        template <std::size_t Size>
+        using atomic_optional_word = typename std::conditional<
+            Size < sizeof(std::uint16_t), std::uint16_t,
+            typename std::conditional<Size < sizeof(std::uint32_t), std::uint32_t,
+                                      std::uint64_t>::type>::type;
+    } // namespace detail
+
+    /// An optional value that can be accessed by multiple threads concurrently,
+    /// like a [std::atomic<T>]() of a [type_safe::optional<T>]().
+    ///
+    /// The value and whether or not there is one are packed into a single atomic unsigned integer,
+    /// so all operations are lock-free if the platform supports atomic integers of that size.
+    /// The value is never accessed directly, all operations take and return [type_safe::optional<T>]() objects.
+    /// \requires `T` must be trivially copyable, smaller than [std::uint64_t]()
+    /// and must not have padding bits, as `compare_exchange_weak/strong()` compare the object representation.
+    template <typename T>
+    class atomic_optional
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+        static_assert(sizeof(T) < sizeof(std::uint64_t), "T must be smaller than std::uint64_t");
+
+        using word = detail::atomic_optional_word<sizeof(T)>;
+
+    public:
+        using value_type = T;
+
+        /// \effects Creates it without a value.
+        atomic_optional() noexcept : word_(0u)
+        {
+        }
+
+        /// \effects Creates it without a value.
+        atomic_optional(nullopt_t) noexcept : atomic_optional()
+        {
+        }
+
+        /// \effects Creates it with the same value as `value`, if it has one.
+        /// \notes The initialization is not atomic.
+        atomic_optional(const optional<T>& value) noexcept : word_(to_word(value))
+        {
+        }
+
+        atomic_optional(const atomic_optional&) = delete;
+        atomic_optional& operator=(const atomic_optional&) = delete;
+
+        /// \returns Whether or not the operations are lock-free.
+        bool is_lock_free() const noexcept
+        {
+            return word_.is_lock_free();
+        }
+
+        /// \returns A copy of the current value, if there is any.
+        optional<T> load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+        {
+            return from_word(word_.load(order));
+        }
+
+        /// \effects Atomically replaces the current value with a copy of `value`,
+        /// or removes the current value if `value` does not have one.
+        void store(const optional<T>& value,
+                   std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            word_.store(to_word(value), order);
+        }
+
+        /// \effects Atomically replaces the current value with a copy of `value`,
+        /// or removes the current value if `value` does not have one.
+        /// \returns The previous value, if there was any.
+        optional<T> exchange(const optional<T>& value,
+                             std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return from_word(word_.exchange(to_word(value), order));
+        }
+
+        /// \effects Atomically removes the current value, if there is any.
+        /// \returns The previous value, if there was any.
+        optional<T> reset(std::memory_order order = std::memory_order_seq_cst) noexcept
+        {
+            return exchange(nullopt, order);
+        }
+
+        /// \effects If the current value is equal to `expected`, replaces it with `desired`,
+        /// otherwise assigns the current value to `expected`.
+        /// Two empty optionals are equal, an empty optional is not equal to one with a value,
+        /// and values are equal if their object representations are.
+        /// \returns Whether or not the value was replaced,
+        /// like [std::atomic<T>::compare_exchange_weak()]() it may fail spuriously.
+        bool compare_exchange_weak(optional<T>& expected, const optional<T>& desired,
+                                   std::memory_order success = std::memory_order_seq_cst,
+                                   std::memory_order failure = std::memory_order_seq_cst) noexcept
+        {
+            auto expected_word = to_word(expected);
+            auto result =
+                word_.compare_exchange_weak(expected_word, to_word(desired), success, failure);
+            if (!result)
+                expected = from_word(expected_word);
+            return result;
+        }
+
+        /// \effects Same as `compare_exchange_weak()`.
+        /// \returns Whether or not the value was replaced, it never fails spuriously.
+        bool compare_exchange_strong(optional<T>& expected, const optional<T>& desired,
+                                     std::memory_order success = std::memory_order_seq_cst,
+                                     std::memory_order failure = std::memory_order_seq_cst) noexcept
+        {
+            auto expected_word = to_word(expected);
+            auto result =
+                word_.compare_exchange_strong(expected_word, to_word(desired), success, failure);
+            if (!result)
+                expected = from_word(expected_word);
+            return result;
+        }
+
+    private:
+        // the value is stored in the first bytes, followed by the presence byte,
+        // all other bytes are zero, so equal optionals have equal words regardless of endianness
+        static word to_word(const optional<T>& value) noexcept
+        {
+            unsigned char bytes[sizeof(word)] = {};
+            if (value.has_value())
+            {
+                std::memcpy(bytes, &value.value(), sizeof(T));
+                bytes[sizeof(T)] = 1u;
+            }
+
+            word result;
+            std::memcpy(&result, bytes, sizeof(word));
+            return result;
+        }
+
+        static optional<T> from_word(word w) noexcept
+        {
+            unsigned char bytes[sizeof(word)];
+            std::memcpy(bytes, &w, sizeof(word));
+            if (bytes[sizeof(T)] == 0u)
+                return nullopt;
+
+            // T does not need to be default constructible
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+            std::memcpy(&storage, bytes, sizeof(T));
+            return *reinterpret_cast<T*>(&storage);
+        }
+
+        std::atomic<word> word_;
+    };
+} // namespace type_safe
+
+#endif // TYPE_SAFE_ATOMIC_OPTIONAL_HPP_INCLUDED
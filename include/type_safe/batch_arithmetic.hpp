@@ -0,0 +1,188 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_BATCH_ARITHMETIC_HPP_INCLUDED
+#define TYPE_SAFE_BATCH_ARITHMETIC_HPP_INCLUDED
+
+#include <cstddef>
+#include <type_traits>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/array_ref.hpp>
+#include <type_safe/integer.hpp>
+
+namespace type_safe
+{
+    /// \exclude
+    namespace detail
+    {
+        template <class Policy>
+        auto has_batch_error_impl(int) -> decltype(Policy::do_batch_error(""), std::true_type{});
+
+        template <class Policy>
+        std::false_type has_batch_error_impl(short);
+
+        template <class Policy>
+        using has_batch_error = decltype(has_batch_error_impl<Policy>(0));
+
+        struct batch_addition
+        {
+            static const char* message() noexcept
+            {
+                return "addition will result in overflow";
+            }
+
+            template <typename T>
+            static T compute(const T& a, const T& b, bool& error) noexcept
+            {
+                auto result = wrapping_addition(a, b);
+                error = did_addition_error(integer_tag_for<T>{}, a, b, result);
+                return result;
+            }
+
+            template <class Policy, typename T>
+            static T compute(const T& a, const T& b)
+            {
+                return Policy::template do_addition(a, b);
+            }
+        };
+
+        struct batch_subtraction
+        {
+            static const char* message() noexcept
+            {
+                return "subtraction will result in underflow";
+            }
+
+            template <typename T>
+            static T compute(const T& a, const T& b, bool& error) noexcept
+            {
+                auto result = wrapping_subtraction(a, b);
+                error = did_subtraction_error(integer_tag_for<T>{}, a, b, result);
+                return result;
+            }
+
+            template <class Policy, typename T>
+            static T compute(const T& a, const T& b)
+            {
+                return Policy::template do_subtraction(a, b);
+            }
+        };
+
+        struct batch_multiplication
+        {
+            static const char* message() noexcept
+            {
+                return "multiplication will result in overflow";
+            }
+
+            // the product is checked in a type twice as wide, which can be vectorized,
+            // but there is no such type for 64 bit integers:
+            // they use the overflow builtin if available, which is cheaper than a division,
+            // but the loop is not vectorized then
+            template <typename T>
+            static T compute(const T& a, const T& b, bool& error) noexcept
+            {
+                error = did_multiplication_error(a, b);
+                return wrapping_multiplication(a, b);
+            }
+
+            template <class Policy, typename T>
+            static T compute(const T& a, const T& b)
+            {
+                return Policy::template do_multiplication(a, b);
+            }
+        };
+
+        // policy supports batch errors: compute everything, check once
+        template <class Op, typename T, class Policy>
+        void batch_operation(std::true_type, integer<T, Policy>* out, const integer<T, Policy>* a,
+                             const integer<T, Policy>* b, std::size_t size)
+        {
+            // accumulate the flags in an integer, so the reduction can be vectorized
+            unsigned error = 0u;
+            for (std::size_t i = 0u; i != size; ++i)
+            {
+                bool lane_error;
+                out[i] = Op::compute(static_cast<T>(a[i]), static_cast<T>(b[i]), lane_error);
+                error |= static_cast<unsigned>(lane_error);
+            }
+
+            if (error)
+                Policy::do_batch_error(Op::message());
+        }
+
+        // policy does not support batch errors: use its regular operations
+        template <class Op, typename T, class Policy>
+        void batch_operation(std::false_type, integer<T, Policy>* out, const integer<T, Policy>* a,
+                             const integer<T, Policy>* b, std::size_t size)
+        {
+            for (std::size_t i = 0u; i != size; ++i)
+                out[i] = Op::template compute<Policy>(static_cast<T>(a[i]), static_cast<T>(b[i]));
+        }
+
+        template <class Op, typename T, class Policy>
+        void batch_operation(array_ref<integer<T, Policy>>       out,
+                             array_ref<const integer<T, Policy>> a,
+                             array_ref<const integer<T, Policy>> b)
+        {
+            DEBUG_ASSERT(a.size() == b.size() && out.size() == a.size(), detail::assert_handler{},
+                         "size mismatch");
+            batch_operation<Op>(has_batch_error<Policy>{}, out.data(), a.data(), b.data(),
+                                out.size());
+        }
+    } // namespace detail
+
+    /// \effects Sets `out[i]` to `a[i] + b[i]` for all `i`.
+    /// If the `Policy` provides a `static` function `do_batch_error(const char*)`,
+    /// the sums are computed with wrapping arithmetic and over/underflow is tracked for the entire batch:
+    /// if any of them under/overflowed, `do_batch_error()` is called once after all sums have been computed.
+    /// This allows the compiler to vectorize the loop even with a checking `Policy`.
+    /// Otherwise `out[i]` is computed by the `do_addition()` function of the `Policy`.
+    /// \throws Anything thrown by `do_batch_error()` or `do_addition()`,
+    /// the contents of `out` are unspecified then.
+    /// \requires All ranges must have the same size, `out` may be the same as `a` or `b`,
+    /// but must not overlap otherwise.
+    /// \notes [type_safe::checked_arithmetic]() throws and [type_safe::undefined_behavior_arithmetic]() asserts
+    /// at most once per batch.
+    template <typename T, class Policy>
+    void add(array_ref<integer<T, Policy>>                            out,
+             detail::non_deduced_t<array_ref<const integer<T, Policy>>> a,
+             detail::non_deduced_t<array_ref<const integer<T, Policy>>> b)
+    {
+        detail::batch_operation<detail::batch_addition>(out, a, b);
+    }
+
+    /// \effects Sets `out[i]` to `a[i] - b[i]` for all `i`.
+    /// Over/underflow is handled as described for `add()`.
+    /// \throws Anything thrown by `do_batch_error()` or `do_subtraction()`,
+    /// the contents of `out` are unspecified then.
+    /// \requires All ranges must have the same size, `out` may be the same as `a` or `b`,
+    /// but must not overlap otherwise.
+    template <typename T, class Policy>
+    void subtract(array_ref<integer<T, Policy>>                            out,
+                  detail::non_deduced_t<array_ref<const integer<T, Policy>>> a,
+                  detail::non_deduced_t<array_ref<const integer<T, Policy>>> b)
+    {
+        detail::batch_operation<detail::batch_subtraction>(out, a, b);
+    }
+
+    /// \effects Sets `out[i]` to `a[i] * b[i]` for all `i`.
+    /// Over/underflow is handled as described for `add()`.
+    /// \throws Anything thrown by `do_batch_error()` or `do_multiplication()`,
+    /// the contents of `out` are unspecified then.
+    /// \requires All ranges must have the same size, `out` may be the same as `a` or `b`,
+    /// but must not overlap otherwise.
+    /// \notes The loop is only vectorized if `T` is at most half as wide as `long long`,
+    /// for wider types every product is checked on its own, but still reported once per batch.
+    template <typename T, class Policy>
+    void multiply(array_ref<integer<T, Policy>>                            out,
+                  detail::non_deduced_t<array_ref<const integer<T, Policy>>> a,
+                  detail::non_deduced_t<array_ref<const integer<T, Policy>>> b)
+    {
+        detail::batch_operation<detail::batch_multiplication>(out, a, b);
+    }
+} // namespace type_safe
+
+#endif // TYPE_SAFE_BATCH_ARITHMETIC_HPP_INCLUDED
@@ -5,9 +5,14 @@
 #ifndef TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
 #define TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
 
+#include <cstdint>
+#include <limits>
 #include <type_traits>
+#include <vector>
 
+#include <type_safe/array_ref.hpp>
 #include <type_safe/constrained_type.hpp>
+#include <type_safe/integer.hpp>
 
 namespace type_safe
 {
@@ -95,7 +100,7 @@ namespace type_safe
             }
 
             template <typename U>
-            bool operator()(const U& u)
+            bool operator()(const U& u) const
             {
                 return lower_(u) && upper_(u);
             }
@@ -124,6 +129,37 @@ namespace type_safe
         /// A value is valid if it is between two given bounds or the bounds themselves.
         template <typename T>
         using closed_interval = bounded<T, closed, closed>;
+
+        /// A `Constraint` for the [type_safe::constrained_type<T, Constraint, Verifier>]().
+        /// A value is valid if it is between `Lower` and `Upper` or one of the bounds themselves.
+        ///
+        /// Unlike [type_safe::constraints::closed_interval<T>]() the bounds are template parameters,
+        /// so it is stateless and the value is compared against constants.
+        /// Open bounds are not needed, as they are the closed bounds `Lower + 1` and `Upper - 1`.
+        /// \requires `T` must be an integral type other than `bool` and `Lower <= Upper`.
+        template <typename T, T Lower, T Upper>
+        struct static_bounded
+        {
+            static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                          "T must be an integral type");
+            static_assert(Lower <= Upper, "invalid bounds");
+
+            template <typename U>
+            constexpr bool operator()(const U& u) const
+            {
+                return !(u < Lower) && !(Upper < u);
+            }
+
+            static constexpr T get_lower_bound() noexcept
+            {
+                return Lower;
+            }
+
+            static constexpr T get_upper_bound() noexcept
+            {
+                return Upper;
+            }
+        };
     } // namespace constraints
 
     /// \exclude
@@ -155,6 +191,339 @@ namespace type_safe
     using bounded_type =
         constrained_type<T, constraints::bounded<T, LowerInclusive, UpperInclusive>>;
 
+    /// An alias for [type_safe::constrained_type<T, Constraint, Verifier>]() that uses [type_safe::constraints::static_bounded<T, Lower, Upper>]() as its `Constraint`.
+    /// \notes This is some type where the values must be in an interval known at compile-time.
+    /// Unlike [type_safe::bounded_type<T, LowerInclusive, UpperInclusive>]() it has the same size as `T`,
+    /// and the sum, difference and product of two of them is another `static_bounded_type`
+    /// whose interval is computed at compile-time, so it is not checked again.
+    /// Use [type_safe::bounded_cast()]() to convert such a result into the type used for storage.
+    template <typename T, T Lower, T Upper>
+    using static_bounded_type = constrained_type<T, constraints::static_bounded<T, Lower, Upper>>;
+
+    /// \exclude
+    namespace detail
+    {
+        template <typename T, T Lower, T Upper, class Verifier>
+        using static_bounded_of =
+            constrained_type<T, constraints::static_bounded<T, Lower, Upper>, Verifier>;
+
+        //=== interval arithmetic ===//
+        // the intervals are computed in std::intmax_t
+        template <typename T>
+        constexpr bool fits_intmax(T value) noexcept
+        {
+            return !(value > T(0))
+                   || static_cast<std::uintmax_t>(value)
+                          <= static_cast<std::uintmax_t>(std::numeric_limits<std::intmax_t>::max());
+        }
+
+        template <typename T>
+        constexpr bool integer_fits(std::intmax_t lower, std::intmax_t upper) noexcept
+        {
+            return lower >= static_cast<std::intmax_t>(std::numeric_limits<T>::min())
+                   && (upper < 0
+                       || static_cast<std::uintmax_t>(upper)
+                              <= static_cast<std::uintmax_t>(std::numeric_limits<T>::max()));
+        }
+
+        template <std::intmax_t Lower, std::intmax_t Upper, typename T, typename... Ts>
+        struct narrowest_integer_impl
+        {
+            using type = typename std::conditional<
+                integer_fits<T>(Lower, Upper), T,
+                typename narrowest_integer_impl<Lower, Upper, Ts...>::type>::type;
+        };
+
+        template <std::intmax_t Lower, std::intmax_t Upper, typename T>
+        struct narrowest_integer_impl<Lower, Upper, T>
+        {
+            using type = T;
+        };
+
+        // the narrowest integer type that can store all values in [Lower, Upper],
+        // unsigned if there are no negative values
+        template <std::intmax_t Lower, std::intmax_t Upper>
+        using narrowest_integer = typename std::conditional<
+            Lower >= 0,
+            typename narrowest_integer_impl<Lower, Upper, std::uint_least8_t, std::uint_least16_t,
+                                            std::uint_least32_t, std::uintmax_t>::type,
+            typename narrowest_integer_impl<Lower, Upper, std::int_least8_t, std::int_least16_t,
+                                            std::int_least32_t, std::intmax_t>::type>::type;
+
+        struct static_bounded_addition
+        {
+            static constexpr bool will_error(std::intmax_t lower1, std::intmax_t upper1,
+                                             std::intmax_t lower2, std::intmax_t upper2) noexcept
+            {
+                return will_addition_error(signed_integer_tag{}, lower1, lower2)
+                       || will_addition_error(signed_integer_tag{}, upper1, upper2);
+            }
+
+            static constexpr std::intmax_t lower(std::intmax_t lower1, std::intmax_t,
+                                                 std::intmax_t lower2, std::intmax_t) noexcept
+            {
+                return wrapping_addition(lower1, lower2);
+            }
+
+            static constexpr std::intmax_t upper(std::intmax_t, std::intmax_t upper1,
+                                                 std::intmax_t, std::intmax_t upper2) noexcept
+            {
+                return wrapping_addition(upper1, upper2);
+            }
+
+            template <typename T>
+            static T apply(T a, T b) noexcept
+            {
+                return wrapping_addition(a, b);
+            }
+        };
+
+        struct static_bounded_subtraction
+        {
+            static constexpr bool will_error(std::intmax_t lower1, std::intmax_t upper1,
+                                             std::intmax_t lower2, std::intmax_t upper2) noexcept
+            {
+                return will_subtraction_error(signed_integer_tag{}, lower1, upper2)
+                       || will_subtraction_error(signed_integer_tag{}, upper1, lower2);
+            }
+
+            static constexpr std::intmax_t lower(std::intmax_t lower1, std::intmax_t,
+                                                 std::intmax_t, std::intmax_t upper2) noexcept
+            {
+                return wrapping_subtraction(lower1, upper2);
+            }
+
+            static constexpr std::intmax_t upper(std::intmax_t, std::intmax_t upper1,
+                                                 std::intmax_t lower2, std::intmax_t) noexcept
+            {
+                return wrapping_subtraction(upper1, lower2);
+            }
+
+            template <typename T>
+            static T apply(T a, T b) noexcept
+            {
+                return wrapping_subtraction(a, b);
+            }
+        };
+
+        // the extremes of the product are products of the bounds
+        struct static_bounded_multiplication
+        {
+            static constexpr bool will_error(std::intmax_t lower1, std::intmax_t upper1,
+                                             std::intmax_t lower2, std::intmax_t upper2) noexcept
+            {
+                return will_multiplication_error(signed_integer_tag{}, lower1, lower2)
+                       || will_multiplication_error(signed_integer_tag{}, lower1, upper2)
+                       || will_multiplication_error(signed_integer_tag{}, upper1, lower2)
+                       || will_multiplication_error(signed_integer_tag{}, upper1, upper2);
+            }
+
+            static constexpr std::intmax_t min(std::intmax_t a, std::intmax_t b) noexcept
+            {
+                return b < a ? b : a;
+            }
+
+            static constexpr std::intmax_t max(std::intmax_t a, std::intmax_t b) noexcept
+            {
+                return a < b ? b : a;
+            }
+
+            static constexpr std::intmax_t lower(std::intmax_t lower1, std::intmax_t upper1,
+                                                 std::intmax_t lower2,
+                                                 std::intmax_t upper2) noexcept
+            {
+                return min(min(wrapping_multiplication(lower1, lower2),
+                               wrapping_multiplication(lower1, upper2)),
+                           min(wrapping_multiplication(upper1, lower2),
+                               wrapping_multiplication(upper1, upper2)));
+            }
+
+            static constexpr std::intmax_t upper(std::intmax_t lower1, std::intmax_t upper1,
+                                                 std::intmax_t lower2,
+                                                 std::intmax_t upper2) noexcept
+            {
+                return max(max(wrapping_multiplication(lower1, lower2),
+                               wrapping_multiplication(lower1, upper2)),
+                           max(wrapping_multiplication(upper1, lower2),
+                               wrapping_multiplication(upper1, upper2)));
+            }
+
+            template <typename T>
+            static T apply(T a, T b) noexcept
+            {
+                return wrapping_multiplication(a, b);
+            }
+        };
+
+        template <class Op, typename T1, T1 Lower1, T1 Upper1, typename T2, T2 Lower2, T2 Upper2,
+                  class Verifier>
+        struct static_bounded_operation
+        {
+            static_assert(fits_intmax(Upper1) && fits_intmax(Upper2),
+                          "bounds must be representable in std::intmax_t");
+
+            static constexpr std::intmax_t lower1 = static_cast<std::intmax_t>(Lower1);
+            static constexpr std::intmax_t upper1 = static_cast<std::intmax_t>(Upper1);
+            static constexpr std::intmax_t lower2 = static_cast<std::intmax_t>(Lower2);
+            static constexpr std::intmax_t upper2 = static_cast<std::intmax_t>(Upper2);
+
+            static_assert(!Op::will_error(lower1, upper1, lower2, upper2),
+                          "interval of the result is not representable in std::intmax_t");
+
+            static constexpr std::intmax_t lower = Op::lower(lower1, upper1, lower2, upper2);
+            static constexpr std::intmax_t upper = Op::upper(lower1, upper1, lower2, upper2);
+
+            using value_type = narrowest_integer<lower, upper>;
+            using type       = static_bounded_of<value_type, static_cast<value_type>(lower),
+                                           static_cast<value_type>(upper), Verifier>;
+
+            // the result is in the interval, so it is the same as the result of the operation
+            // modulo 2^N, where N is the number of bits of value_type:
+            // the operation can be performed in value_type with wrapping arithmetic
+            static type apply(T1 a, T2 b) noexcept
+            {
+                return unverified_constructor::make<type>(
+                    Op::apply(static_cast<value_type>(a), static_cast<value_type>(b)));
+            }
+        };
+    } // namespace detail
+
+    /// \returns The sum of the values of `a` and `b`.
+    /// Its interval is the sum of the intervals, so it is not checked again,
+    /// and its `value_type` is the narrowest integer type that can store the interval.
+    /// The result uses the same `Verifier` as `a` and `b`,
+    /// operands with different verifiers must be converted with [type_safe::bounded_cast()]() first.
+    /// \notes If the interval of the sum is not representable in [std::intmax_t](), this is a compile-time error,
+    /// so the addition never overflows.
+    template <typename T1, T1 Lower1, T1 Upper1, typename T2, T2 Lower2, T2 Upper2,
+              class Verifier>
+    typename detail::static_bounded_operation<detail::static_bounded_addition, T1, Lower1,
+                                              Upper1, T2, Lower2, Upper2, Verifier>::type
+        operator+(const detail::static_bounded_of<T1, Lower1, Upper1, Verifier>& a,
+                  const detail::static_bounded_of<T2, Lower2, Upper2, Verifier>& b) noexcept
+    {
+        return detail::static_bounded_operation<detail::static_bounded_addition, T1, Lower1,
+                                                Upper1, T2, Lower2, Upper2,
+                                                Verifier>::apply(a.get_value(), b.get_value());
+    }
+
+    /// \returns The difference of the values of `a` and `b`.
+    /// Its interval is computed from the intervals of `a` and `b`, so it is not checked again,
+    /// and its `value_type` is the narrowest integer type that can store the interval.
+    /// The result uses the same `Verifier` as `a` and `b`,
+    /// operands with different verifiers must be converted with [type_safe::bounded_cast()]() first.
+    /// \notes If the interval of the difference is not representable in [std::intmax_t](), this is a compile-time error.
+    template <typename T1, T1 Lower1, T1 Upper1, typename T2, T2 Lower2, T2 Upper2,
+              class Verifier>
+    typename detail::static_bounded_operation<detail::static_bounded_subtraction, T1, Lower1,
+                                              Upper1, T2, Lower2, Upper2, Verifier>::type
+        operator-(const detail::static_bounded_of<T1, Lower1, Upper1, Verifier>& a,
+                  const detail::static_bounded_of<T2, Lower2, Upper2, Verifier>& b) noexcept
+    {
+        return detail::static_bounded_operation<detail::static_bounded_subtraction, T1, Lower1,
+                                                Upper1, T2, Lower2, Upper2,
+                                                Verifier>::apply(a.get_value(), b.get_value());
+    }
+
+    /// \returns The product of the values of `a` and `b`.
+    /// Its interval is computed from the intervals of `a` and `b`, so it is not checked again,
+    /// and its `value_type` is the narrowest integer type that can store the interval.
+    /// The result uses the same `Verifier` as `a` and `b`,
+    /// operands with different verifiers must be converted with [type_safe::bounded_cast()]() first.
+    /// \notes If the interval of the product is not representable in [std::intmax_t](), this is a compile-time error.
+    template <typename T1, T1 Lower1, T1 Upper1, typename T2, T2 Lower2, T2 Upper2,
+              class Verifier>
+    typename detail::static_bounded_operation<detail::static_bounded_multiplication, T1, Lower1,
+                                              Upper1, T2, Lower2, Upper2, Verifier>::type
+        operator*(const detail::static_bounded_of<T1, Lower1, Upper1, Verifier>& a,
+                  const detail::static_bounded_of<T2, Lower2, Upper2, Verifier>& b) noexcept
+    {
+        return detail::static_bounded_operation<detail::static_bounded_multiplication, T1, Lower1,
+                                                Upper1, T2, Lower2, Upper2,
+                                                Verifier>::apply(a.get_value(), b.get_value());
+    }
+
+    /// \exclude
+    namespace detail
+    {
+        // the interval of a target type of bounded_cast() and how to create it
+        template <typename Target, typename = void>
+        struct static_interval
+        {
+            static_assert(std::is_integral<Target>::value && !std::is_same<Target, bool>::value,
+                          "invalid target type");
+
+            static constexpr std::intmax_t lower =
+                static_cast<std::intmax_t>(std::numeric_limits<Target>::min());
+            static constexpr std::intmax_t upper =
+                fits_intmax(std::numeric_limits<Target>::max()) ?
+                    static_cast<std::intmax_t>(std::numeric_limits<Target>::max()) :
+                    std::numeric_limits<std::intmax_t>::max();
+
+            using verifier = assertion_verifier;
+
+            static Target make(std::intmax_t value) noexcept
+            {
+                return static_cast<Target>(value);
+            }
+        };
+
+        template <typename T, class Policy>
+        struct static_interval<integer<T, Policy>> : static_interval<T>
+        {
+            static integer<T, Policy> make(std::intmax_t value) noexcept
+            {
+                return integer<T, Policy>(static_cast<T>(value));
+            }
+        };
+
+        template <typename T, T Lower, T Upper, class Verifier>
+        struct static_interval<static_bounded_of<T, Lower, Upper, Verifier>>
+        {
+            static_assert(fits_intmax(Upper), "bounds must be representable in std::intmax_t");
+
+            static constexpr std::intmax_t lower = static_cast<std::intmax_t>(Lower);
+            static constexpr std::intmax_t upper = static_cast<std::intmax_t>(Upper);
+
+            using verifier = Verifier;
+
+            static static_bounded_of<T, Lower, Upper, Verifier> make(std::intmax_t value) noexcept
+            {
+                return unverified_constructor::make<static_bounded_of<T, Lower, Upper, Verifier>>(
+                    static_cast<T>(value));
+            }
+        };
+    } // namespace detail
+
+    /// \returns The value of the `source` as a `Target`,
+    /// which is a [type_safe::static_bounded_type<T, Lower, Upper>](), a [type_safe::integer<T, Policy>]() or a built-in integer type.
+    /// \effects If the interval of `source` is not contained in the interval of `Target`,
+    /// the value is verified with the `Verifier` of the `Target`, or with [type_safe::assertion_verifier]() for integers.
+    /// Only the bounds of the `Target` the `source` can exceed are checked,
+    /// if it is contained in the interval there is no check at all.
+    /// \notes This is the conversion between the results of the arithmetic operations,
+    /// which have their own `value_type` and interval, and the type used for storage.
+    template <typename Target, typename T, T Lower, T Upper, class Verifier>
+    Target bounded_cast(const detail::static_bounded_of<T, Lower, Upper, Verifier>& source)
+    {
+        static_assert(detail::fits_intmax(Upper), "bounds must be representable in std::intmax_t");
+        using target = detail::static_interval<Target>;
+        // a bound that cannot be exceeded is replaced by the limit of std::intmax_t,
+        // which is true for every value and optimized away
+        using check = constraints::static_bounded<
+            std::intmax_t,
+            static_cast<std::intmax_t>(Lower) < target::lower ?
+                target::lower :
+                std::numeric_limits<std::intmax_t>::min(),
+            target::upper < static_cast<std::intmax_t>(Upper) ?
+                target::upper :
+                std::numeric_limits<std::intmax_t>::max()>;
+
+        auto value = static_cast<std::intmax_t>(source.get_value());
+        target::verifier::verify(value, check{});
+        return target::make(value);
+    }
+
     /// \returns A [type_safe::bounded_type<T, LowerInclusive, UpperInclusive>]() with the given `value` and lower and upper bounds,
     /// where those bounds are valid values as well.
     template <typename T, typename U1, typename U2>
@@ -184,8 +553,11 @@ namespace type_safe
 
     /// \effects Changes `val` so that it is in the interval.
     /// If it is not in the interval, assigns the bound that is closer to the value.
+    /// \notes This function does not participate in overload resolution,
+    /// unless `val` can be compared with the bounds, so a range of values uses the overload below.
     template <typename T, typename U>
-    void clamp(const constraints::closed_interval<T>& interval, U& val)
+    auto clamp(const constraints::closed_interval<T>& interval, U& val)
+        -> decltype(void(val < interval.get_lower_bound()))
     {
         if (val < interval.get_lower_bound())
             val = static_cast<U>(interval.get_lower_bound());
@@ -193,6 +565,60 @@ namespace type_safe
             val = static_cast<U>(interval.get_upper_bound());
     }
 
+    /// \exclude
+    namespace detail
+    {
+        // selects instead of branching, so it compiles to min/max instructions
+        // and a loop over it can be vectorized
+        template <typename T>
+        T clamp_value(T val, const T& lower, const T& upper) noexcept
+        {
+            val = val < lower ? lower : val;
+            return upper < val ? upper : val;
+        }
+    } // namespace detail
+
+    /// \exclude
+    namespace detail
+    {
+        template <typename U>
+        void clamp_range(array_ref<U> vals, const U& lower, const U& upper) noexcept
+        {
+            for (auto& val : vals)
+                val = clamp_value(val, lower, upper);
+        }
+    } // namespace detail
+
+    /// \effects Changes each value in `vals` so that it is in the interval, like `clamp(interval, val)`.
+    /// `vals` can be a [type_safe::array_ref<T>](), an array or a contiguous container like `std::vector`.
+    /// \notes Unlike the single value version,
+    /// it assigns every value and does not branch, so the loop can be vectorized.
+    /// This function does not participate in overload resolution,
+    /// unless [type_safe::make_array_ref()]() can be called with `vals`.
+    /// \requires The values must be copyable without side effects, like built-in arithmetic types.
+    template <typename T, class Range>
+    auto clamp(const constraints::closed_interval<T>& interval, Range&& vals)
+        -> decltype(void(make_array_ref(vals)))
+    {
+        using value_type = typename decltype(make_array_ref(vals))::value_type;
+        detail::clamp_range(make_array_ref(vals),
+                            static_cast<value_type>(interval.get_lower_bound()),
+                            static_cast<value_type>(interval.get_upper_bound()));
+    }
+
+    /// \effects Changes each value in `vals` so that it is in the interval of the [type_safe::constraints::static_bounded<T, Lower, Upper>]().
+    /// `vals` can be a [type_safe::array_ref<T>](), an array or a contiguous container like `std::vector`.
+    /// \notes Like the overload for [type_safe::constraints::closed_interval<T>]() it does not branch.
+    /// \requires The values must be copyable without side effects, like built-in arithmetic types.
+    template <typename T, T Lower, T Upper, class Range>
+    auto clamp(const constraints::static_bounded<T, Lower, Upper>&, Range&& vals)
+        -> decltype(void(make_array_ref(vals)))
+    {
+        using value_type = typename decltype(make_array_ref(vals))::value_type;
+        detail::clamp_range(make_array_ref(vals), static_cast<value_type>(Lower),
+                            static_cast<value_type>(Upper));
+    }
+
     /// A `Verifier` for [type_safe::constrained_type<T, Constraint, Verifier]() that clamps the value to make it valid.
     /// It must be used together with [type_safe::constraints::less_equal<T>](), [type_safe::constraints::greater_equal<T>]() or [type_safe::constraints::closed_interval<T>]().
     struct clamping_verifier
@@ -223,6 +649,17 @@ namespace type_safe
         {
             clamp(interval, val);
         }
+
+        /// \effects If `val` is not in the interval,
+        /// assigns the bound that is closer to the value.
+        template <typename Value, typename T, T Lower, T Upper>
+        static void verify(Value& val, const constraints::static_bounded<T, Lower, Upper>&)
+        {
+            if (val < Lower)
+                val = static_cast<Value>(Lower);
+            else if (Upper < val)
+                val = static_cast<Value>(Upper);
+        }
     };
 
     /// An alias for [type_safe::constrained_type<T, Constraint, Verifier>]() that uses [type_safe::constraints::closed_interval<T>]() as its `Constraint`
@@ -243,6 +680,29 @@ namespace type_safe
                                                                                  std::forward<U2>(
                                                                                      upper)));
     }
+
+    /// \returns A [std::vector<T>]() of [type_safe::clamped_type<T>]() objects with the given `values` and the `interval`.
+    /// \notes The values are clamped without branches and the objects are created without verifying them again,
+    /// so this is faster than calling `make_clamped()` for each value.
+    template <typename T>
+    std::vector<clamped_type<T>> make_clamped(const constraints::closed_interval<T>&      interval,
+                                              detail::non_deduced_t<array_ref<const T>> values)
+    {
+        using type = clamped_type<T>;
+
+        auto& lower = interval.get_lower_bound();
+        auto& upper = interval.get_upper_bound();
+
+        // fill first and assign in a separate loop without capacity checks
+        std::vector<type> result(values.size(),
+                                 detail::unverified_constructor::make<type>(lower, interval));
+        for (std::size_t i = 0u; i != values.size(); ++i)
+            result[i] = detail::unverified_constructor::make<type>(detail::clamp_value(values[i],
+                                                                                       lower,
+                                                                                       upper),
+                                                                   interval);
+        return result;
+    }
 } // namespace type_safe
 
 #endif // TYPE_SAFE_BOUNDED_TYPE_HPP_INCLUDED
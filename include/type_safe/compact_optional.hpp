@@ -0,0 +1,113 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_COMPACT_OPTIONAL_HPP_INCLUDED
+#define TYPE_SAFE_COMPACT_OPTIONAL_HPP_INCLUDED
+
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/constrained_type.hpp>
+#include <type_safe/optional.hpp>
+
+namespace type_safe
+{
+    /// A trait selecting the `StoragePolicy` of [type_safe::compact_optional<T>]().
+    ///
+    /// By default it is [type_safe::direct_optional_storage<T>](),
+    /// specialize it to give `compact_optional<T>` a more compact storage, i.e. provide a member typedef `type`.
+    /// \notes It is specialized for a [type_safe::constrained_type<T, Constraint, Verifier>]()
+    /// whose `Constraint` has a [type_safe::constraint_niche<Constraint, T>]().
+    template <typename T>
+    struct optional_storage_policy_for
+    {
+        using type = direct_optional_storage<T>;
+    };
+
+    /// A [type_safe::basic_optional<StoragePolicy>]() that use the [type_safe::optional_storage_policy_for<T>](),
+    /// which is [type_safe::direct_optional_storage<T>]() unless specialized.
+    /// \notes Unlike [type_safe::optional<T>](), `T` cannot be deduced from a `compact_optional<T>`.
+    template <typename T>
+    using compact_optional = basic_optional<typename optional_storage_policy_for<T>::type>;
+
+    /// \exclude
+    namespace detail
+    {
+        template <class Constraint, typename T>
+        auto has_niche_impl(int) -> decltype(constraint_niche<Constraint, T>::value(),
+                                             std::true_type{});
+
+        template <class Constraint, typename T>
+        std::false_type has_niche_impl(short);
+
+        template <class Constraint, typename T>
+        using has_niche = decltype(has_niche_impl<Constraint, T>(0));
+
+        template <class ConstrainedType>
+        struct use_niche : std::false_type
+        {
+        };
+
+        // a null_verifier does not guarantee the constraint,
+        // so a value could be mistaken for the niche
+        template <typename T, typename Constraint, typename Verifier>
+        struct use_niche<constrained_type<T, Constraint, Verifier>>
+        : std::integral_constant<bool,
+                                 has_niche<Constraint, T>::value
+                                     && !std::is_same<Verifier, null_verifier>::value
+                                     && std::is_trivially_destructible<
+                                            constrained_type<T, Constraint, Verifier>>::value
+                                     && std::is_nothrow_move_constructible<
+                                            constrained_type<T, Constraint, Verifier>>::value>
+        {
+        };
+
+        template <class ConstrainedType>
+        struct niche_sentinel;
+
+        // Sentinel for sentinel_optional_storage using the niche of the constraint
+        template <typename T, typename Constraint, typename Verifier>
+        struct niche_sentinel<constrained_type<T, Constraint, Verifier>>
+        {
+            using type = constrained_type<T, Constraint, Verifier>;
+
+            static type value() noexcept
+            {
+                auto niche = constraint_niche<Constraint, typename type::value_type>::value();
+                DEBUG_ASSERT(!Constraint()(niche), detail::assert_handler{},
+                             "niche must not fulfill the constraint");
+                return unverified_constructor::make<type>(std::move(niche));
+            }
+
+            static bool is_sentinel(const type& t) noexcept
+            {
+                return !t.get_constraint()(t.get_value());
+            }
+        };
+    } // namespace detail
+
+    /// Specialization of the [type_safe::optional_storage_policy_for<T>]() for a [type_safe::constrained_type<T, Constraint, Verifier>]().
+    ///
+    /// If the `Constraint` has a [type_safe::constraint_niche<Constraint, T>](),
+    /// it is a [type_safe::sentinel_optional_storage<T, Sentinel>]() using the niche as the empty state,
+    /// so the optional has the same size as the `constrained_type`,
+    /// e.g. for [type_safe::constraints::non_null]().
+    /// Otherwise it is the [type_safe::direct_optional_storage<T>]().
+    /// \notes Every stored value that does not fulfill the `Constraint` is treated as the empty state.
+    /// The niche is therefore not used with the [type_safe::null_verifier](),
+    /// i.e. for a [type_safe::tagged_type<T, Constraint>](),
+    /// and a custom `Verifier` must not allow invalid values.
+    template <typename T, typename Constraint, typename Verifier>
+    struct optional_storage_policy_for<constrained_type<T, Constraint, Verifier>>
+    : std::conditional<detail::use_niche<constrained_type<T, Constraint, Verifier>>::value,
+                       sentinel_optional_storage<constrained_type<T, Constraint, Verifier>,
+                                                 detail::niche_sentinel<
+                                                     constrained_type<T, Constraint, Verifier>>>,
+                       direct_optional_storage<constrained_type<T, Constraint, Verifier>>>
+    {
+    };
+} // namespace type_safe
+
+#endif // TYPE_SAFE_COMPACT_OPTIONAL_HPP_INCLUDED
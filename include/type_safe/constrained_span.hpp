@@ -0,0 +1,237 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_CONSTRAINED_SPAN_HPP_INCLUDED
+#define TYPE_SAFE_CONSTRAINED_SPAN_HPP_INCLUDED
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/array_ref.hpp>
+#include <type_safe/constrained_type.hpp>
+
+namespace type_safe
+{
+    /// \exclude
+    namespace detail
+    {
+        // a predicate for an entire range, so the Verifier is called once per range
+        template <class Constraint>
+        struct all_fulfill_predicate
+        {
+            template <typename T>
+            bool operator()(const array_ref<T>& values) const
+            {
+                return all_fulfill(values, constraint);
+            }
+
+            const Constraint& constraint;
+        };
+
+        // a Verifier that accepts an rvalue range cannot change the values,
+        // so it can verify them at once
+        template <class Verifier, typename T, class Constraint>
+        auto is_range_verifier_impl(int)
+            -> decltype(Verifier::verify(std::declval<array_ref<T>>(),
+                                         std::declval<const all_fulfill_predicate<Constraint>&>()),
+                        std::true_type{});
+
+        template <class Verifier, typename T, class Constraint>
+        std::false_type is_range_verifier_impl(short);
+
+        template <class Verifier, typename T, class Constraint>
+        using is_range_verifier = decltype(is_range_verifier_impl<Verifier, T, Constraint>(0));
+    } // namespace detail
+
+    /// A view of existing values of type `T` that all fulfill the predicate `Constraint`,
+    /// like an array of [type_safe::constrained_type<T, Constraint, Verifier>]() without copying the values.
+    ///
+    /// If the `Verifier` cannot change the values, like [type_safe::assertion_verifier]() and [type_safe::null_verifier](),
+    /// it is called once for an entire range of values, with a predicate that checks each value against the `Constraint`.
+    /// Otherwise it is called for each value, so a `Verifier` like [type_safe::clamping_verifier]() can change them.
+    /// A `modifier` gives write access to a range of the values and verifies only that range again.
+    /// \requires `T` must not be a reference, `Constraint` must be a functor of type `bool(const T&)`
+    /// and `Verifier` must provide a `static` function `void verify([const] T&, const Predicate&)`,
+    /// like for [type_safe::constrained_type<T, Constraint, Verifier>]().
+    /// It is considered to not change the values if `verify()` can also be called
+    /// with an rvalue [type_safe::array_ref<T>]() of the values and the predicate for the range.
+    /// The values must outlive it and must only be modified through a `modifier` while it is used,
+    /// as it only stores a reference to them.
+    template <typename T, typename Constraint, typename Verifier = assertion_verifier>
+    class constrained_span
+    : detail::constraint_storage<constrained_span<T, Constraint, Verifier>, Constraint>
+    {
+        static_assert(!std::is_reference<T>::value, "T must not be a reference");
+
+        using storage = detail::constraint_storage<constrained_span, Constraint>;
+
+    public:
+        using value_type             = typename std::remove_cv<T>::type;
+        using constraint_predicate   = Constraint;
+        using constrained_value_type = constrained_type<value_type, Constraint, Verifier>;
+
+        /// \effects Creates it viewing the valid `values` and giving it a `predicate`.
+        /// The values will not be copied, all of them are verified.
+        explicit constrained_span(array_ref<T> values, constraint_predicate predicate = {})
+        : storage(std::move(predicate)), values_(values)
+        {
+            verify(values_);
+        }
+
+        /// A proxy class to provide write access to a range of the values.
+        /// The destructor will verify that range again.
+        class modifier
+        {
+        public:
+            /// \effects Move constructs it.
+            /// `other` will not verify any values afterwards.
+            modifier(modifier&& other) noexcept : span_(other.span_), range_(other.range_)
+            {
+                other.span_ = nullptr;
+            }
+
+            /// \effects Verifies the range, if there is any.
+            ~modifier() noexcept(false)
+            {
+                if (span_)
+                    span_->verify(range_);
+            }
+
+            /// \effects Move assigns it.
+            /// `other` will not verify any values afterwards.
+            modifier& operator=(modifier&& other) noexcept
+            {
+                span_       = other.span_;
+                range_      = other.range_;
+                other.span_ = nullptr;
+                return *this;
+            }
+
+            /// \returns A reference to the range of values.
+            /// \requires It must not be in the moved-from state.
+            array_ref<T> get() const noexcept
+            {
+                DEBUG_ASSERT(span_, detail::assert_handler{});
+                return range_;
+            }
+
+        private:
+            modifier(constrained_span& span, array_ref<T> range) noexcept
+            : span_(&span), range_(range)
+            {
+            }
+
+            constrained_span* span_;
+            array_ref<T>      range_;
+            friend constrained_span;
+        };
+
+        /// \returns A proxy object to provide verified write-access to all values.
+        modifier modify() noexcept
+        {
+            return modify(0u, size());
+        }
+
+        /// \returns A proxy object to provide verified write-access to the `count` values starting at `first`,
+        /// only those are verified again.
+        /// \requires `first + count <= size()`.
+        modifier modify(std::size_t first, std::size_t count) noexcept
+        {
+            static_assert(!std::is_const<T>::value, "cannot modify const values");
+            return modifier(*this, values_.subrange(first, count));
+        }
+
+        /// \returns The number of values.
+        std::size_t size() const noexcept
+        {
+            return values_.size();
+        }
+
+        /// \returns Whether or not there are no values.
+        bool empty() const noexcept
+        {
+            return values_.empty();
+        }
+
+        /// \returns A `const` reference to the `i`th value.
+        /// \requires `i < size()` and any `const` operations on the `value_type` must not affect the validity of the value.
+        const value_type& get_value(std::size_t i) const noexcept
+        {
+            return values_[i];
+        }
+
+        /// \returns A read-only [type_safe::array_ref<T>]() to all values.
+        array_ref<const value_type> get_values() const noexcept
+        {
+            return array_ref<const value_type>(values_.data(), values_.size());
+        }
+
+        /// \returns The `i`th value as a [type_safe::constrained_type<T, Constraint, Verifier>](),
+        /// it is copied but not verified again, use `get_value()` to access it without a copy.
+        /// \requires `i < size()`.
+        constrained_value_type operator[](std::size_t i) const
+        {
+            return detail::unverified_constructor::make<constrained_value_type>(values_[i],
+                                                                                get_constraint());
+        }
+
+        /// \returns The predicate that determines validity.
+        /// \notes If it is stateless, this is a default constructed predicate, not the one passed to the constructor.
+        const constraint_predicate& get_constraint() const noexcept
+        {
+            return storage::get_constraint();
+        }
+
+    private:
+        void verify(array_ref<T> range) const
+        {
+            verify(detail::is_range_verifier<Verifier, T, Constraint>{}, range);
+        }
+
+        void verify(std::true_type, array_ref<T> range) const
+        {
+            Verifier::verify(std::move(range),
+                             detail::all_fulfill_predicate<Constraint>{get_constraint()});
+        }
+
+        void verify(std::false_type, array_ref<T> range) const
+        {
+            for (auto& val : range)
+                Verifier::verify(val, get_constraint());
+        }
+
+        array_ref<T> values_;
+    };
+
+    /// \returns A [type_safe::constrained_span<T, Constraint, Verifier>]() viewing the given `values` with the `Constraint`.
+    template <typename T, typename Constraint>
+    constrained_span<T, Constraint> make_constrained_span(array_ref<T> values, Constraint c)
+    {
+        return constrained_span<T, Constraint>(values, std::move(c));
+    }
+
+    /// \returns A [type_safe::constrained_span<T, Constraint, Verifier>]() viewing the given `values` with the `Constraint` and `Verifier`.
+    template <class Verifier, typename T, typename Constraint>
+    constrained_span<T, Constraint, Verifier> make_constrained_span(array_ref<T> values,
+                                                                    Constraint   c)
+    {
+        return constrained_span<T, Constraint, Verifier>(values, std::move(c));
+    }
+
+    /// An alias for [type_safe::constrained_span<T, Constraint, Verifier>]() that never checks the constraint,
+    /// the equivalent of [type_safe::tagged_type<T, Constraint>]() for a range of values.
+    template <typename T, typename Constraint>
+    using tagged_span = constrained_span<T, Constraint, null_verifier>;
+
+    /// \returns A [type_safe::tagged_span<T, Constraint>]() viewing the given `values` with the `Constraint`.
+    template <typename T, typename Constraint>
+    tagged_span<T, Constraint> make_tagged_span(array_ref<T> values, Constraint c)
+    {
+        return tagged_span<T, Constraint>(values, std::move(c));
+    }
+} // namespace type_safe
+
+#endif // TYPE_SAFE_CONSTRAINED_SPAN_HPP_INCLUDED
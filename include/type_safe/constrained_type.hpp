@@ -7,8 +7,10 @@
 
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <type_safe/detail/assert.hpp>
+#include <type_safe/array_ref.hpp>
 
 namespace type_safe
 {
@@ -35,19 +37,110 @@ namespace type_safe
         struct is_valid : decltype(verify_static_constrained<Constraint, T>(0))
         {
         };
+
+        // creates a constrained type from a value without verifying it,
+        // for values that are valid by construction and the niche
+        struct unverified_constructor
+        {
+            template <class ConstrainedType>
+            static ConstrainedType make(typename ConstrainedType::value_type           value,
+                                        typename ConstrainedType::constraint_predicate predicate)
+            {
+                return ConstrainedType(typename ConstrainedType::unverified_tag{},
+                                       std::move(value), std::move(predicate));
+            }
+
+            template <class ConstrainedType>
+            static ConstrainedType make(typename ConstrainedType::value_type value)
+            {
+                return make<ConstrainedType>(std::move(value),
+                                             typename ConstrainedType::constraint_predicate());
+            }
+        };
+
+        // checks all values without an early exit, so the loop can be vectorized
+        template <typename T, class Predicate>
+        bool all_fulfill(array_ref<T> values, const Predicate& p)
+        {
+            unsigned invalid = 0u;
+            for (auto& val : values)
+                invalid |= static_cast<unsigned>(!p(val));
+            return invalid == 0u;
+        }
+
+        template <class Constraint>
+        using is_stateless_constraint =
+            std::integral_constant<bool, std::is_empty<Constraint>::value
+                                             && std::is_default_constructible<Constraint>::value>;
+
+        // stores the Constraint using the empty base optimization, if possible
+        // ConstrainedType makes the storage unique, so nested constrained types don't share it
+        template <class ConstrainedType, class Constraint,
+                  bool Stateless = is_stateless_constraint<Constraint>::value>
+        class constraint_storage : Constraint
+        {
+        protected:
+            explicit constraint_storage(Constraint&& c) : Constraint(std::move(c))
+            {
+            }
+
+            const Constraint& get_constraint() const noexcept
+            {
+                return *this;
+            }
+        };
+
+        // a stateless Constraint is not stored at all:
+        // if it shared a base with the value, the empty base optimization would not be possible
+        template <class ConstrainedType, class Constraint>
+        class constraint_storage<ConstrainedType, Constraint, true>
+        {
+        protected:
+            explicit constraint_storage(Constraint&&) noexcept
+            {
+            }
+
+            const Constraint& get_constraint() const noexcept
+            {
+                static const Constraint constraint{};
+                return constraint;
+            }
+        };
     } // namespace detail
 
+    /// A trait specifying the "niche" of a `Constraint`, a value of type `T` that never fulfills it.
+    ///
+    /// A specialization must provide a `static` function `value()` returning that value.
+    /// Then [type_safe::compact_optional<T>]() of a [type_safe::constrained_type<T, Constraint, Verifier>]()
+    /// uses it to mark the empty state instead of a `bool` flag,
+    /// if `T` is trivially destructible and nothrow move constructible,
+    /// see `compact_optional.hpp`.
+    /// The default does not specify a niche, it is only specialized for [type_safe::constraints::non_null]().
+    /// Specialize it for your own types, e.g. for [type_safe::constraints::non_empty]() and a view type
+    /// whose default constructed value is empty.
+    /// \notes The optional treats every value not fulfilling the `Constraint` as the empty state,
+    /// so the `Constraint` must be default constructible and must not have any state.
+    template <class Constraint, typename T, typename = void>
+    struct constraint_niche
+    {
+    };
+
     /// A value of type `T` that always fulfills the predicate `Constraint`.
     /// The `Constraint` is checked by the `Verifier`.
     /// The `Constraint` can also provide a nested template `is_valid<T>` to statically check types.
     /// Those will be checked regardless of the `Verifier`.
+    /// If the `Constraint` is stateless - empty and default constructible - it is not stored,
+    /// so a `constrained_type` has the same size as `T`, see [type_safe::is_value_layout_compatible<ConstrainedType>]().
     /// \requires `T` must not be a reference, `Constraint` must be a functor of type `bool(const T&)`
     /// and `Verifier` must provide a `static` function `void verify([const] T&, const Predicate&)`.
     template <typename T, typename Constraint, typename Verifier = assertion_verifier>
-    class constrained_type : Constraint, Verifier
+    class constrained_type
+    : detail::constraint_storage<constrained_type<T, Constraint, Verifier>, Constraint>
     {
         static_assert(!std::is_reference<T>::value, "T must not be a reference");
 
+        using storage = detail::constraint_storage<constrained_type, Constraint>;
+
     public:
         using value_type           = typename std::remove_cv<T>::type;
         using constraint_predicate = Constraint;
@@ -55,7 +148,7 @@ namespace type_safe
         /// \effects Creates it giving it a valid `value` and a `predicate`.
         /// The `value` will be copied and verified.
         explicit constrained_type(const value_type& value, constraint_predicate predicate = {})
-        : Constraint(std::move(predicate)), value_(value)
+        : storage(std::move(predicate)), value_(value)
         {
             verify();
         }
@@ -63,7 +156,7 @@ namespace type_safe
         /// \effects Creates it giving it a valid `value` and a `predicate`.
         /// The `value` will be moved and verified.
         explicit constrained_type(value_type&& value, constraint_predicate predicate = {})
-        : Constraint(std::move(predicate)), value_(std::move(value))
+        : storage(std::move(predicate)), value_(std::move(value))
         {
             verify();
         }
@@ -163,18 +256,31 @@ namespace type_safe
         }
 
         /// \returns The predicate that determines validity.
+        /// \notes If it is stateless, this is a default constructed predicate, not the one passed to the constructor.
         const constraint_predicate& get_constraint() const noexcept
         {
-            return *this;
+            return storage::get_constraint();
         }
 
     private:
+        struct unverified_tag
+        {
+        };
+
+        // creates it without verifying
+        constrained_type(unverified_tag, value_type value, constraint_predicate predicate)
+        : storage(std::move(predicate)), value_(std::move(value))
+        {
+        }
+
         void verify()
         {
             Verifier::verify(value_, get_constraint());
         }
 
         value_type value_;
+
+        friend detail::unverified_constructor;
     };
 
     /// \returns A [type_safe::constrained_type<T, Constraint, Verifier>]() with the given `value` and `Constraint`.
@@ -206,6 +312,160 @@ namespace type_safe
         std::forward<Func>(f)(modifier.get());
     }
 
+    /// Whether or not a [type_safe::constrained_type<T, Constraint, Verifier>]() has the same size and alignment as its `value_type`,
+    /// so an array of it takes as much memory as an array of the `value_type`.
+    ///
+    /// This is the case if the `Constraint` is stateless and the `value_type` is a standard layout type.
+    /// The default is `false`.
+    /// \notes An array of it still must not be accessed as an array of the `value_type`,
+    /// use `get_value()` on each object instead.
+    template <class ConstrainedType>
+    struct is_value_layout_compatible : std::false_type
+    {
+    };
+
+    template <typename T, typename Constraint, typename Verifier>
+    struct is_value_layout_compatible<constrained_type<T, Constraint, Verifier>>
+    : std::integral_constant<
+          bool,
+          sizeof(constrained_type<T, Constraint, Verifier>) == sizeof(T)
+              && alignof(constrained_type<T, Constraint, Verifier>) == alignof(T)
+              && std::is_standard_layout<constrained_type<T, Constraint, Verifier>>::value>
+    {
+    };
+
+    /// A read-only view of values that were checked against a `Constraint` all at once,
+    /// created by [type_safe::constrain_all()]().
+    ///
+    /// If all of them fulfill the `Constraint`, it hands out [type_safe::constrained_type<T, Constraint, Verifier>]() objects
+    /// without verifying them again.
+    /// Otherwise it provides the indices of the invalid values, so they can be reported together.
+    /// \requires The values must outlive it and must not be modified while it is used,
+    /// as it only stores a reference to them and they are only checked on construction.
+    template <class ConstrainedType>
+    class constrained_batch
+    {
+        using underlying_type = typename ConstrainedType::value_type;
+
+    public:
+        using value_type           = ConstrainedType;
+        using constraint_predicate = typename ConstrainedType::constraint_predicate;
+
+        /// \effects Creates it from the `values` and checks all of them against the `predicate`.
+        /// The values are checked in a single pass without an early exit, so it can be vectorized,
+        /// the indices of the invalid values are only collected if there are any.
+        explicit constrained_batch(array_ref<const underlying_type> values,
+                                   constraint_predicate             predicate = {})
+        : values_(values), predicate_(std::move(predicate))
+        {
+            if (!detail::all_fulfill(values_, predicate_))
+                for (std::size_t i = 0u; i != values_.size(); ++i)
+                    if (!predicate_(values_[i]))
+                        invalid_.push_back(i);
+        }
+
+        /// \returns `true` if all values fulfill the constraint, `false` otherwise.
+        explicit operator bool() const noexcept
+        {
+            return is_valid();
+        }
+
+        /// \returns `true` if all values fulfill the constraint, `false` otherwise.
+        bool is_valid() const noexcept
+        {
+            return invalid_.empty();
+        }
+
+        /// \returns The index of the first value that does not fulfill the constraint.
+        /// \requires `is_valid()` must be `false`.
+        std::size_t first_invalid() const noexcept
+        {
+            DEBUG_ASSERT(!is_valid(), detail::assert_handler{}, "all values are valid");
+            return invalid_.front();
+        }
+
+        /// \returns The indices of all values that do not fulfill the constraint in increasing order.
+        array_ref<const std::size_t> invalid_indices() const noexcept
+        {
+            return array_ref<const std::size_t>(invalid_.data(), invalid_.size());
+        }
+
+        /// \returns The number of values.
+        std::size_t size() const noexcept
+        {
+            return values_.size();
+        }
+
+        /// \returns The values, regardless of whether they are valid.
+        array_ref<const underlying_type> values() const noexcept
+        {
+            return values_;
+        }
+
+        /// \returns The `i`th value as a constrained type, it is not verified again.
+        /// \requires `is_valid()` must be `true` and `i < size()`.
+        /// \notes In debug mode it is checked that the value has not been modified to an invalid one.
+        value_type operator[](std::size_t i) const
+        {
+            DEBUG_ASSERT(is_valid(), detail::assert_handler{}, "values do not fulfill constraint");
+            DEBUG_ASSERT(predicate_(values_[i]), detail::assert_handler{},
+                         "value was modified after the batch was created");
+            return detail::unverified_constructor::make<value_type>(values_[i], predicate_);
+        }
+
+        /// \returns A [std::vector<T>]() containing all values as constrained types,
+        /// they are not verified again.
+        /// \requires `is_valid()` must be `true`.
+        std::vector<value_type> to_vector() const
+        {
+            DEBUG_ASSERT(is_valid(), detail::assert_handler{}, "values do not fulfill constraint");
+            if (values_.empty())
+                return {};
+
+            // fill first and assign in a separate loop without capacity checks
+            std::vector<value_type> result(values_.size(), (*this)[0u]);
+            for (std::size_t i = 1u; i != values_.size(); ++i)
+                result[i] = (*this)[i];
+            return result;
+        }
+
+        /// \returns The predicate the values were checked against.
+        const constraint_predicate& get_constraint() const noexcept
+        {
+            return predicate_;
+        }
+
+    private:
+        array_ref<const underlying_type> values_;
+        constraint_predicate             predicate_;
+        std::vector<std::size_t>         invalid_;
+    };
+
+    /// \returns A [type_safe::constrained_batch<ConstrainedType>]() of the given `values`
+    /// checked against the `Constraint`,
+    /// it hands out [type_safe::constrained_type<T, Constraint, Verifier>]() objects.
+    /// \notes Unlike creating each object with [type_safe::constrain()](),
+    /// this does not call the `Verifier` for every value,
+    /// but reports all invalid values at once.
+    template <typename T, typename Constraint>
+    auto constrain_all(array_ref<T> values, Constraint c)
+        -> constrained_batch<constrained_type<typename std::remove_const<T>::type, Constraint>>
+    {
+        using type = constrained_type<typename std::remove_const<T>::type, Constraint>;
+        return constrained_batch<type>(values, std::move(c));
+    }
+
+    /// \returns A [type_safe::constrained_batch<ConstrainedType>]() of the given `values`
+    /// checked against the `Constraint`,
+    /// it hands out [type_safe::constrained_type<T, Constraint, Verifier>]() objects with the given `Verifier`.
+    template <class Verifier, typename T, typename Constraint>
+    auto constrain_all(array_ref<T> values, Constraint c) -> constrained_batch<
+        constrained_type<typename std::remove_const<T>::type, Constraint, Verifier>>
+    {
+        using type = constrained_type<typename std::remove_const<T>::type, Constraint, Verifier>;
+        return constrained_batch<type>(values, std::move(c));
+    }
+
     /// A `Verifier` for [type_safe::constrained_type<T, Constraint, Verifier]() that doesn't check the constraint.
     struct null_verifier
     {
@@ -314,6 +574,16 @@ namespace type_safe
         {
         };
     } // namespace constraints
+
+    /// The niche of [type_safe::constraints::non_null]() is `nullptr`.
+    template <typename T>
+    struct constraint_niche<constraints::non_null, T*>
+    {
+        static constexpr T* value() noexcept
+        {
+            return nullptr;
+        }
+    };
 } // namespace type_safe
 
 #endif // TYPE_SAFE_CONSTRAINED_TYPE_HPP_INCLUDED
@@ -0,0 +1,97 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_HASH_CACHED_HPP_INCLUDED
+#define TYPE_SAFE_HASH_CACHED_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace type_safe
+{
+    /// A value of type `T` together with its hash computed by `Hash`.
+    ///
+    /// The hash is computed once on construction, [std::hash]() returns the stored hash,
+    /// and the equality comparison compares the hashes before the values.
+    /// This makes repeated lookups in hash containers cheap for types that are expensive to hash, like strings.
+    /// It can be used as the underlying type of a [type_safe::strong_typedef<Tag, T>]()
+    /// with [type_safe::hashable<StrongTypedef>](),
+    /// or as the value of a [type_safe::basic_optional<StoragePolicy>]().
+    /// \notes The value cannot be modified, as the hash would be outdated otherwise.
+    template <typename T, class Hash = std::hash<T>>
+    class hash_cached
+    {
+    public:
+        using value_type = T;
+
+        /// \effects Creates a default constructed value and computes its hash.
+        hash_cached() : hash_cached(T())
+        {
+        }
+
+        /// \effects Copies the `value` and computes its hash.
+        explicit hash_cached(const T& value) : value_(value), hash_(Hash{}(value_))
+        {
+        }
+
+        /// \effects Moves the `value` and computes its hash.
+        explicit hash_cached(T&& value) : value_(std::move(value)), hash_(Hash{}(value_))
+        {
+        }
+
+        /// \returns A reference to the value.
+        const T& get() const noexcept
+        {
+            return value_;
+        }
+
+        /// \returns A reference to the value.
+        explicit operator const T&() const noexcept
+        {
+            return value_;
+        }
+
+        /// \returns The hash of the value.
+        std::size_t hash() const noexcept
+        {
+            return hash_;
+        }
+
+        /// \returns `true` if both hashes and both values are equal, `false` otherwise.
+        /// \notes The values are only compared if the hashes are equal.
+        friend bool operator==(const hash_cached& lhs, const hash_cached& rhs)
+        {
+            return lhs.hash_ == rhs.hash_ && lhs.value_ == rhs.value_;
+        }
+
+        /// \returns `!(lhs == rhs)`.
+        friend bool operator!=(const hash_cached& lhs, const hash_cached& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        T           value_;
+        std::size_t hash_;
+    };
+} // namespace type_safe
+
+namespace std
+{
+    template <typename T, class Hash>
+    struct hash<type_safe::hash_cached<T, Hash>>
+    {
+        using argument_type = type_safe::hash_cached<T, Hash>;
+        using result_type   = std::size_t;
+
+        std::size_t operator()(const type_safe::hash_cached<T, Hash>& value) const noexcept
+        {
+            return value.hash();
+        }
+    };
+} // namespace std
+
+#endif // TYPE_SAFE_HASH_CACHED_HPP_INCLUDED
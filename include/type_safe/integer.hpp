@@ -155,7 +155,7 @@ namespace type_safe
         {
             static_assert(std::is_signed<integer_type>::value,
                           "cannot call unary minus on unsigned integer");
-            return -value_;
+            return Policy::template do_subtraction<integer_type>(integer_type(0), value_);
         }
 
         TYPE_SAFE_FORCE_INLINE integer& operator++()
@@ -199,7 +199,7 @@ namespace type_safe
         template <typename T, typename = detail::enable_safe_integer_conversion<T, integer_type>>
         TYPE_SAFE_FORCE_INLINE integer& operator+=(const integer<T, Policy>& other)
         {
-            value_ = Policy::template do_addition(value_, static_cast<T>(other));
+            value_ = Policy::template do_addition<integer_type>(value_, static_cast<T>(other));
             return *this;
         }
         TYPE_SAFE_DETAIL_MAKE_OP(+=)
@@ -207,7 +207,7 @@ namespace type_safe
         template <typename T, typename = detail::enable_safe_integer_conversion<T, integer_type>>
         TYPE_SAFE_FORCE_INLINE integer& operator-=(const integer<T, Policy>& other)
         {
-            value_ = Policy::template do_subtraction(value_, static_cast<T>(other));
+            value_ = Policy::template do_subtraction<integer_type>(value_, static_cast<T>(other));
             return *this;
             return *this;
         }
@@ -216,7 +216,8 @@ namespace type_safe
         template <typename T, typename = detail::enable_safe_integer_conversion<T, integer_type>>
         TYPE_SAFE_FORCE_INLINE integer& operator*=(const integer<T, Policy>& other)
         {
-            value_ = Policy::template do_multiplication(value_, static_cast<T>(other));
+            value_ =
+                Policy::template do_multiplication<integer_type>(value_, static_cast<T>(other));
             return *this;
         }
         TYPE_SAFE_DETAIL_MAKE_OP(*=)
@@ -224,7 +225,7 @@ namespace type_safe
         template <typename T, typename = detail::enable_safe_integer_conversion<T, integer_type>>
         TYPE_SAFE_FORCE_INLINE integer& operator/=(const integer<T, Policy>& other)
         {
-            value_ = Policy::template do_division(value_, static_cast<T>(other));
+            value_ = Policy::template do_division<integer_type>(value_, static_cast<T>(other));
             return *this;
         }
         TYPE_SAFE_DETAIL_MAKE_OP(/=)
@@ -232,7 +233,7 @@ namespace type_safe
         template <typename T, typename = detail::enable_safe_integer_conversion<T, integer_type>>
         TYPE_SAFE_FORCE_INLINE integer& operator%=(const integer<T, Policy>& other)
         {
-            value_ = Policy::template do_modulo(value_, static_cast<T>(other));
+            value_ = Policy::template do_modulo<integer_type>(value_, static_cast<T>(other));
             return *this;
         }
         TYPE_SAFE_DETAIL_MAKE_OP(%=)
@@ -479,6 +480,122 @@ namespace type_safe
 
 #undef TYPE_SAFE_DETAIL_MAKE_OP
 
+    //=== widening operations ===//
+    /// \exclude
+    namespace detail
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef __int128 int128_t;
+        __extension__ typedef unsigned __int128 uint128_t;
+
+        // only usable if the standard library treats them as integers,
+        // which is not the case in strict ISO mode
+        using extended_signed_integer =
+            typename std::conditional<std::is_integral<int128_t>::value, int128_t, void>::type;
+        using extended_unsigned_integer =
+            typename std::conditional<std::is_integral<uint128_t>::value, uint128_t, void>::type;
+#else
+        using extended_signed_integer   = void;
+        using extended_unsigned_integer = void;
+#endif
+
+        // the smallest integer type with twice the size of T, or void
+        template <typename T, typename Short, typename Int, typename LongLong, typename Extended>
+        using select_wider_integer = typename std::conditional<
+            sizeof(Short) >= 2 * sizeof(T), Short,
+            typename std::conditional<
+                sizeof(Int) >= 2 * sizeof(T), Int,
+                typename std::conditional<sizeof(LongLong) >= 2 * sizeof(T), LongLong,
+                                          Extended>::type>::type>::type;
+
+        template <typename T>
+        using wider_signed_integer =
+            select_wider_integer<T, short, int, long long, extended_signed_integer>;
+
+        template <typename T>
+        using wider_unsigned_integer =
+            select_wider_integer<T, unsigned short, unsigned, unsigned long long,
+                                 extended_unsigned_integer>;
+
+        template <typename T>
+        using wider_integer = typename std::conditional<std::is_signed<T>::value,
+                                                        wider_signed_integer<T>,
+                                                        wider_unsigned_integer<T>>::type;
+
+        template <typename T, typename Result>
+        using enable_wider_integer =
+            typename std::enable_if<!std::is_void<T>::value, Result>::type;
+
+        template <typename A, typename B>
+        using widening_result_t = wider_integer<integer_result_t<A, B>>;
+
+        // a - b is negative for a < b, so unsigned operands give a signed result
+        template <typename A, typename B>
+        using widening_difference_t = wider_signed_integer<integer_result_t<A, B>>;
+    } // namespace detail
+
+    /// \returns The value of `i` in the smallest integer type with at least twice the size.
+    /// \notes This function does not participate in overload resolution,
+    /// unless there is such a type, 128bit integers are used if the compiler supports them.
+    template <typename T, class Policy>
+    TYPE_SAFE_FORCE_INLINE constexpr auto widen(const integer<T, Policy>& i) noexcept
+        -> integer<detail::enable_wider_integer<detail::wider_integer<T>,
+                                                detail::wider_integer<T>>,
+                   Policy>
+    {
+        return static_cast<detail::wider_integer<T>>(static_cast<T>(i));
+    }
+
+    /// \returns The sum of `a` and `b` in the smallest integer type with at least twice the size,
+    /// so it cannot overflow.
+    /// Use [type_safe::narrow_cast]() to get back to the original type,
+    /// checking the range once at the end of a computation.
+    /// \notes This function does not participate in overload resolution,
+    /// unless there is such a type, 128bit integers are used if the compiler supports them.
+    template <typename A, typename B, class Policy>
+    TYPE_SAFE_FORCE_INLINE constexpr auto widening_add(const integer<A, Policy>& a,
+                                                       const integer<B, Policy>& b) noexcept
+        -> integer<detail::enable_wider_integer<detail::widening_result_t<A, B>,
+                                                detail::widening_result_t<A, B>>,
+                   Policy>
+    {
+        using type = detail::widening_result_t<A, B>;
+        return static_cast<type>(static_cast<type>(static_cast<A>(a))
+                                 + static_cast<type>(static_cast<B>(b)));
+    }
+
+    /// \returns The difference of `a` and `b` in the smallest signed integer type
+    /// with at least twice the size, so it cannot under/overflow - even for `unsigned` integers.
+    /// \notes This function does not participate in overload resolution,
+    /// unless there is such a type, 128bit integers are used if the compiler supports them.
+    template <typename A, typename B, class Policy>
+    TYPE_SAFE_FORCE_INLINE constexpr auto widening_subtract(const integer<A, Policy>& a,
+                                                            const integer<B, Policy>& b) noexcept
+        -> integer<detail::enable_wider_integer<detail::widening_difference_t<A, B>,
+                                                detail::widening_difference_t<A, B>>,
+                   Policy>
+    {
+        using type = detail::widening_difference_t<A, B>;
+        return static_cast<type>(static_cast<type>(static_cast<A>(a))
+                                 - static_cast<type>(static_cast<B>(b)));
+    }
+
+    /// \returns The product of `a` and `b` in the smallest integer type with at least twice the size,
+    /// so it cannot overflow.
+    /// \notes This function does not participate in overload resolution,
+    /// unless there is such a type, 128bit integers are used if the compiler supports them.
+    template <typename A, typename B, class Policy>
+    TYPE_SAFE_FORCE_INLINE constexpr auto widening_multiply(const integer<A, Policy>& a,
+                                                            const integer<B, Policy>& b) noexcept
+        -> integer<detail::enable_wider_integer<detail::widening_result_t<A, B>,
+                                                detail::widening_result_t<A, B>>,
+                   Policy>
+    {
+        using type = detail::widening_result_t<A, B>;
+        return static_cast<type>(static_cast<type>(static_cast<A>(a))
+                                 * static_cast<type>(static_cast<B>(b)));
+    }
+
     //=== input/output ===/
     template <typename Char, class CharTraits, typename IntegerT, class Policy>
     std::basic_istream<Char, CharTraits>& operator>>(std::basic_istream<Char, CharTraits>& in,
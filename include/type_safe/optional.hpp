@@ -6,6 +6,8 @@
 #define TYPE_SAFE_OPTIONAL_HPP_INCLUDED
 
 #include <functional>
+#include <initializer_list>
+#include <limits>
 #include <new>
 #include <type_traits>
 
@@ -100,6 +102,177 @@ namespace type_safe
         {
             return unwrap_optional(need_unwrap_optional<Optional>{}, std::forward<Optional>(opt));
         }
+
+        //=== optional_storage ===//
+        struct policy_value_tag
+        {
+        };
+
+        // the destructor is trivial if value_type and the policy are trivially destructible
+        template <class StoragePolicy>
+        using is_trivially_destructible_optional =
+            std::integral_constant<bool,
+                                   std::is_trivially_destructible<
+                                       typename StoragePolicy::value_type>::value
+                                       && std::is_trivially_destructible<StoragePolicy>::value>;
+
+        // stores the StoragePolicy and destroys the value
+        template <class StoragePolicy,
+                  bool Trivial = is_trivially_destructible_optional<StoragePolicy>::value>
+        class optional_destructor
+        {
+        protected:
+            optional_destructor() = default;
+
+            template <typename T>
+            constexpr optional_destructor(policy_value_tag, T&& value)
+            : policy_(std::forward<T>(value))
+            {
+            }
+
+            // used by optional_storage<StoragePolicy, true>
+            optional_destructor(const optional_destructor&) = default;
+            optional_destructor(optional_destructor&&)      = default;
+
+            ~optional_destructor() noexcept
+            {
+                if (policy_.has_value())
+                    policy_.destroy_value();
+            }
+
+            optional_destructor& operator=(const optional_destructor&) = default;
+            optional_destructor& operator=(optional_destructor&&) = default;
+
+            StoragePolicy policy_;
+        };
+
+        template <class StoragePolicy>
+        class optional_destructor<StoragePolicy, true>
+        {
+        protected:
+            optional_destructor() = default;
+
+            template <typename T>
+            constexpr optional_destructor(policy_value_tag, T&& value)
+            : policy_(std::forward<T>(value))
+            {
+            }
+
+            StoragePolicy policy_;
+        };
+
+        // the copy and move operations are trivial if value_type and the policy are trivially
+        // copyable, as copying the bytes of the policy is then the same as copying the value
+        template <class StoragePolicy>
+        using is_trivial_optional =
+            std::integral_constant<bool,
+                                   std::is_trivially_copyable<
+                                       typename StoragePolicy::value_type>::value
+                                       && std::is_trivially_copyable<StoragePolicy>::value>;
+
+        // the policy declares that its own copy and move operations copy and move the value
+        template <class StoragePolicy, typename = void>
+        struct policy_copies_value : std::false_type
+        {
+        };
+
+        template <class StoragePolicy>
+        struct policy_copies_value<StoragePolicy, typename StoragePolicy::copies_value>
+        : std::true_type
+        {
+        };
+
+        template <class StoragePolicy, bool CopiesValue = policy_copies_value<StoragePolicy>::value>
+        struct is_nothrow_swappable_optional
+        : std::integral_constant<bool,
+                                 std::is_nothrow_move_constructible<
+                                     typename StoragePolicy::value_type>::value
+                                     && is_nothrow_swappable<
+                                            typename StoragePolicy::value_type>::value>
+        {
+        };
+
+        // the optionals are swapped by moving the policies
+        template <class StoragePolicy>
+        struct is_nothrow_swappable_optional<StoragePolicy, true>
+        : std::integral_constant<bool, std::is_nothrow_move_constructible<StoragePolicy>::value
+                                           && std::is_nothrow_move_assignable<StoragePolicy>::value>
+        {
+        };
+
+        // implements the copy and move operations of basic_optional
+        template <class StoragePolicy,
+                  bool UsePolicy = is_trivial_optional<StoragePolicy>::value
+                                   || policy_copies_value<StoragePolicy>::value>
+        class optional_storage : public optional_destructor<StoragePolicy>
+        {
+        protected:
+            using value_type = typename StoragePolicy::value_type;
+
+            optional_storage() = default;
+
+            template <typename T>
+            constexpr optional_storage(policy_value_tag tag, T&& value)
+            : optional_destructor<StoragePolicy>(tag, std::forward<T>(value))
+            {
+            }
+
+            optional_storage(const optional_storage& other) : optional_destructor<StoragePolicy>()
+            {
+                if (other.policy_.has_value())
+                    this->policy_.create_value(other.policy_.get_value());
+            }
+
+            optional_storage(optional_storage&& other) noexcept(
+                std::is_nothrow_move_constructible<value_type>::value)
+            : optional_destructor<StoragePolicy>()
+            {
+                if (other.policy_.has_value())
+                    this->policy_.create_value(std::move(other.policy_).get_value());
+            }
+
+            ~optional_storage() = default;
+
+            optional_storage& operator=(const optional_storage& other)
+            {
+                if (other.policy_.has_value())
+                    derived().emplace(other.policy_.get_value());
+                else
+                    derived().reset();
+                return *this;
+            }
+
+            optional_storage& operator=(optional_storage&& other) noexcept(
+                std::is_nothrow_move_constructible<value_type>::value&&
+                    std::is_nothrow_move_assignable<value_type>::value)
+            {
+                if (other.policy_.has_value())
+                    derived().emplace(std::move(other.policy_).get_value());
+                else
+                    derived().reset();
+                return *this;
+            }
+
+        private:
+            basic_optional<StoragePolicy>& derived() noexcept
+            {
+                return static_cast<basic_optional<StoragePolicy>&>(*this);
+            }
+        };
+
+        // uses the copy and move operations of the policy
+        template <class StoragePolicy>
+        class optional_storage<StoragePolicy, true> : public optional_destructor<StoragePolicy>
+        {
+        protected:
+            optional_storage() = default;
+
+            template <typename T>
+            constexpr optional_storage(policy_value_tag tag, T&& value)
+            : optional_destructor<StoragePolicy>(tag, std::forward<T>(value))
+            {
+            }
+        };
     } // namespace detail
 
     //=== basic_optional ===//
@@ -132,8 +305,17 @@ namespace type_safe
     /// * `U get_value() (const)& noexcept` - returns a reference to the stored value, U is one of the `XXX_reference` typedefs
     /// * `U get_value() (const)&& noexcept` - returns a reference to the stored value, U is one of the `XXX_reference` typedefs
     /// * `U get_value_or(T&& val) [const&/&&]` - returns either `get_value()` or `val`
+    ///
+    /// If the `StoragePolicy` provides a typedef `copies_value` to `void`,
+    /// its copy and move operations are used to copy and move the value,
+    /// instead of `create_value()` with the `value()` of the other optional.
+    ///
+    /// If both the `value_type` and the `StoragePolicy` are trivially copyable,
+    /// it is trivially copyable as well, so it can be copied with `std::memcpy()` and passed in registers.
+    /// \notes It is never trivial, as the default constructor has to create the "empty" state,
+    /// so a `std::vector` can still move the elements one by one instead of with `std::memmove()` when it grows.
     template <class StoragePolicy>
-    class basic_optional
+    class basic_optional : public detail::optional_storage<StoragePolicy>
     {
     public:
         using storage    = StoragePolicy;
@@ -143,7 +325,11 @@ namespace type_safe
         using rebind = basic_optional<typename StoragePolicy::template rebind<U>>;
 
     private:
-        storage policy_;
+        using detail::optional_storage<StoragePolicy>::policy_;
+
+        template <typename T>
+        using remove_cv_ref =
+            typename std::remove_cv<typename std::remove_reference<T>::type>::type;
 
     public:
         //=== constructors/destructors/assignment/swap ===//
@@ -151,28 +337,41 @@ namespace type_safe
         basic_optional() noexcept = default;
 
         /// \effects Same as the default constructor.
-        basic_optional(nullopt_t) noexcept
+        constexpr basic_optional(nullopt_t) noexcept
         {
         }
 
         /// \effects Creates it with a value by forwarding `value`.
         /// \throws Anything thrown by the constructor of `value_type`.
         /// \requires The `create_value()` function of the `StoragePolicy` must accept `value`.
-        template <typename T>
+        template <typename T,
+                  typename std::enable_if<!std::is_constructible<StoragePolicy, T&&>::value,
+                                          int>::type = 0>
         basic_optional(T&& value, decltype(policy_.create_value(std::forward<T>(value)), 0) = 0)
         {
             policy_.create_value(std::forward<T>(value));
         }
 
+        /// \effects Creates it with a value by forwarding `value` to the constructor of the `StoragePolicy`.
+        /// \throws Anything thrown by the constructor of `value_type`.
+        /// \requires The `create_value()` function of the `StoragePolicy` must accept `value`.
+        /// \notes This constructor is used instead of the one above if the `StoragePolicy` can be constructed from `value`,
+        /// then it is `constexpr`, see [type_safe::constexpr_optional_storage<T>]().
+        template <typename T,
+                  typename std::enable_if<std::is_constructible<StoragePolicy, T&&>::value,
+                                          int>::type = 0>
+        constexpr basic_optional(T&& value,
+                                 decltype(policy_.create_value(std::forward<T>(value)), 0) = 0)
+        : detail::optional_storage<StoragePolicy>(detail::policy_value_tag{},
+                                                  std::forward<T>(value))
+        {
+        }
+
         /// \effects Copy constructor:
         /// If `other` does not have a value, it will be created without a value as well.
         /// If `other` has a value, it will be created with a value by copying `other.value()`.
         /// \throws Anything thrown by the copy constructor of `value_type` if `other` has a value.
-        basic_optional(const basic_optional& other)
-        {
-            if (other.has_value())
-                policy_.create_value(other.value());
-        }
+        basic_optional(const basic_optional& other) = default;
 
         /// \effects Move constructor:
         /// If `other` does not have a value, it will be created without a value as well.
@@ -180,18 +379,10 @@ namespace type_safe
         /// \throws Anything thrown by the move constructor of `value_type` if `other` has a value.
         /// \notes `other` will still have a value after the move operation,
         /// it is just in a moved-from state.
-        basic_optional(basic_optional&& other) noexcept(
-            std::is_nothrow_move_constructible<value_type>::value)
-        {
-            if (other.has_value())
-                policy_.create_value(std::move(other).value());
-        }
+        basic_optional(basic_optional&& other) = default;
 
         /// \effects If it has a value, it will be destroyed.
-        ~basic_optional() noexcept
-        {
-            reset();
-        }
+        ~basic_optional() = default;
 
         /// \effects Same as `reset()`.
         basic_optional& operator=(nullopt_t) noexcept
@@ -214,38 +405,36 @@ namespace type_safe
         /// If `other` has a value, calls `emplace(other.value())` (this will always trigger the single parameter version).
         /// Otherwise calls `reset()`.
         /// \throws Anything thrown by the call to `emplace()`.
-        basic_optional& operator=(const basic_optional& other)
-        {
-            if (other.has_value())
-                emplace(other.value());
-            else
-                reset();
-            return *this;
-        }
+        basic_optional& operator=(const basic_optional& other) = default;
 
         /// \effects Move assignment operator:
         /// If `other` has a value, calls `emplace(std::move(other).value())` (this will always trigger the single parameter version).
         /// Otherwise calls `reset()`.
         /// \throws Anything thrown by the call to `emplace()`.
-        basic_optional& operator=(basic_optional&& other) noexcept(
-            std::is_nothrow_move_constructible<value_type>::value&&
-                std::is_nothrow_move_assignable<value_type>::value)
-        {
-            if (other.has_value())
-                emplace(std::move(other).value());
-            else
-                reset();
-            return *this;
-        }
+        basic_optional& operator=(basic_optional&& other) = default;
 
         /// \effects Swap.
         /// If both `a` and `b` have values, swaps the values with their swap function.
         /// Otherwise, if only one of them have a value, moves that value to the other one and makes the moved-from empty.
         /// Otherwise, if both are empty, does nothing.
+        /// If the `StoragePolicy` copies the value itself, the optionals are swapped by moving them instead.
         /// \throws Anything thrown by the move construction or swap.
         friend void swap(basic_optional& a, basic_optional& b) noexcept(
-            std::is_nothrow_move_constructible<value_type>::value&&
-                detail::is_nothrow_swappable<value_type>::value)
+            detail::is_nothrow_swappable_optional<StoragePolicy>::value)
+        {
+            swap_impl(detail::policy_copies_value<StoragePolicy>{}, a, b);
+        }
+
+    private:
+        // the policy knows how to move the value, swapping the values directly could slice them
+        static void swap_impl(std::true_type, basic_optional& a, basic_optional& b)
+        {
+            basic_optional tmp(std::move(a));
+            a = std::move(b);
+            b = std::move(tmp);
+        }
+
+        static void swap_impl(std::false_type, basic_optional& a, basic_optional& b)
         {
             if (a.has_value() && b.has_value())
             {
@@ -264,6 +453,7 @@ namespace type_safe
             }
         }
 
+    public:
         //=== modifiers ===//
         /// \effects Destroys the value by calling its destructor, if there is any stored.
         /// Afterwards `has_value()` will return `false`.
@@ -281,7 +471,8 @@ namespace type_safe
         /// this function will not participate in overload resolution.
         template <typename... Args>
         auto emplace(Args&&... args) noexcept(
-            std::is_nothrow_constructible<value_type, Args...>::value)
+            std::is_nothrow_constructible<value_type, Args...>::value
+            && !detail::policy_copies_value<StoragePolicy>::value)
             -> decltype(this->policy_.create_value(std::forward<Args>(args)...))
         {
             reset();
@@ -294,10 +485,12 @@ namespace type_safe
         /// \notes This function does not participate in overload resolution
         /// unless there is an `operator=` that takes `arg` without an implicit user-defined conversion
         /// and the `create_value()` function of the `StoragePolicy` accepts the argument.
-        template <
-            typename Arg,
-            typename =
-                typename std::enable_if<detail::is_direct_assignable<value_type, Arg>::value>::type>
+        /// It also does not participate if the `StoragePolicy` copies the value itself,
+        /// as the stored type might be different.
+        template <typename Arg,
+                  typename = typename std::enable_if<
+                      detail::is_direct_assignable<value_type, Arg>::value
+                      && !detail::policy_copies_value<StoragePolicy>::value>::type>
         auto emplace(Arg&& arg) noexcept(std::is_nothrow_constructible<value_type, Arg>::value&&
                                              std::is_nothrow_assignable<value_type, Arg>::value)
             -> decltype(this->policy_.create_value(std::forward<Arg>(arg)))
@@ -310,13 +503,13 @@ namespace type_safe
 
         //=== observers ===//
         /// \returns The same as `has_value()`.
-        explicit operator bool() const noexcept
+        explicit constexpr operator bool() const noexcept
         {
             return has_value();
         }
 
         /// \returns Whether or not the optional has a value.
-        bool has_value() const noexcept
+        constexpr bool has_value() const noexcept
         {
             return policy_.has_value();
         }
@@ -331,10 +524,11 @@ namespace type_safe
 
         /// \returns A `const` reference to the stored value.
         /// \requires `has_value() == true`.
-        auto value() const & noexcept -> decltype(policy_.get_value())
+        constexpr auto value() const & noexcept -> decltype(policy_.get_value())
         {
-            DEBUG_ASSERT(has_value(), detail::assert_handler{});
-            return policy_.get_value();
+            return has_value() ?
+                       policy_.get_value() :
+                       (DEBUG_UNREACHABLE(detail::assert_handler{}), policy_.get_value());
         }
 
         /// \returns An rvalue reference to the stored value.
@@ -347,17 +541,18 @@ namespace type_safe
 
         /// \returns An rvalue reference to the stored value.
         /// \requires `has_value() == true`.
-        auto value() const && noexcept -> decltype(std::move(policy_).get_value())
+        constexpr auto value() const && noexcept -> decltype(std::move(policy_).get_value())
         {
-            DEBUG_ASSERT(has_value(), detail::assert_handler{});
-            return std::move(policy_).get_value();
+            return has_value() ? std::move(policy_).get_value() :
+                                 (DEBUG_UNREACHABLE(detail::assert_handler{}),
+                                  std::move(policy_).get_value());
         }
 
         /// \returns If it has a value, `value()`, otherwise `u` converted to the same type as `value()`.
         /// \requires `u` must be valid argument to the `value_or()` function of the `StoragePolicy`.
         /// \notes Depending on the `StoragePolicy`, this either returns a decayed type or a reference.
         template <typename U>
-        auto value_or(U&& u) const& -> decltype(policy_.get_value_or(std::forward<U>(u)))
+        constexpr auto value_or(U&& u) const& -> decltype(policy_.get_value_or(std::forward<U>(u)))
         {
             return policy_.get_value_or(std::forward<U>(u));
         }
@@ -371,6 +566,31 @@ namespace type_safe
             return std::move(policy_).get_value_or(std::forward<U>(u));
         }
 
+        /// \returns If it has a value, a copy of `value()`,
+        /// otherwise `std::forward<Func>(f)()` converted to the type of `value()` without cv or references.
+        /// \requires `f` must be callable without arguments.
+        /// \notes Unlike `value_or()`, the fallback is only created if the optional is empty.
+        template <typename Func>
+        constexpr auto value_or_else(Func&& f) const& -> remove_cv_ref<decltype(this->value())>
+        {
+            using result = remove_cv_ref<decltype(this->value())>;
+            return has_value() ? static_cast<result>(value()) :
+                                 static_cast<result>(std::forward<Func>(f)());
+        }
+
+        /// \returns If it has a value, `value()` moved into the result,
+        /// otherwise `std::forward<Func>(f)()` converted to the type of `value()` without cv or references.
+        /// \requires `f` must be callable without arguments.
+        /// \notes Unlike `value_or()`, the fallback is only created if the optional is empty.
+        template <typename Func>
+        auto value_or_else(Func&& f) && -> remove_cv_ref<decltype(std::move(*this).value())>
+        {
+            using result = remove_cv_ref<decltype(std::move(*this).value())>;
+            if (has_value())
+                return static_cast<result>(std::move(*this).value());
+            return static_cast<result>(std::forward<Func>(f)());
+        }
+
         //=== factories ===//
         /// \returns If `value_type` is a `basic_optional` itself, returns a copy of that optional
         /// or a null optional of that type if `has_value()` is `false`.
@@ -391,7 +611,7 @@ namespace type_safe
                   typename std::enable_if<std::is_move_constructible<T>::value, int>::type = 0>
         detail::unwrap_optional_t<basic_optional<StoragePolicy>> unwrap() &&
         {
-            return detail::unwrap_optional(*this);
+            return detail::unwrap_optional(std::move(*this));
         }
 
         /// \returns The return type is the `basic_optional` rebound to the return type of the function when called with `const value_type&`.
@@ -399,12 +619,11 @@ namespace type_safe
         /// otherwise returns an empty optional.
         /// \requires `f` must be callable with `const value_type&`.
         template <typename Func>
-        auto map(Func&& f) const& -> rebind<decltype(std::forward<Func>(f)(this->value()))>
+        constexpr auto map(Func&& f)
+            const& -> rebind<decltype(std::forward<Func>(f)(this->value()))>
         {
-            if (has_value())
-                return std::forward<Func>(f)(value());
-            else
-                return nullopt;
+            using result = rebind<decltype(std::forward<Func>(f)(this->value()))>;
+            return has_value() ? result(std::forward<Func>(f)(value())) : result(nullopt);
         }
 
         /// \returns The return type is the `basic_optional` rebound to the return type of the function when called with `value_type&&`.
@@ -435,29 +654,22 @@ namespace type_safe
         /// \notes This is useful for functions that return an optional type itself,
         /// the optional will be "flattened" properly.
         template <typename Func>
-        auto bind(
-            Func&& f) && -> detail::unwrap_optional_t<decltype(this->map(std::forward<Func>(f)))>
+        auto bind(Func&& f) && -> detail::unwrap_optional_t<
+            decltype(std::move(*this).map(std::forward<Func>(f)))>
         {
-            return map(std::forward<Func>(f)).unwrap();
+            return std::move(*this).map(std::forward<Func>(f)).unwrap();
         }
 
-    private:
-        template <typename T>
-        using remove_cv_ref =
-            typename std::remove_cv<typename std::remove_reference<T>::type>::type;
-
-    public:
         /// \returns If the optional is not empty, `std::forward<Func>(f)(value())` converted to the type `T` without cv or references.
         /// Otherwise returns `std::forward<T>(t)`.
         /// \requires `f` must be callable with `const value_type&`.
         /// \notes This is similar to `map()` but does not wrap the resulting type in an optional.
         /// Hence a fallback value must be provided.
         template <typename T, typename Func>
-        auto transform(T&& t, Func&& f) const& -> remove_cv_ref<T>
+        constexpr auto transform(T&& t, Func&& f) const& -> remove_cv_ref<T>
         {
-            if (has_value())
-                return static_cast<remove_cv_ref<T>>(std::forward<Func>(f)(value()));
-            return std::forward<T>(t);
+            return has_value() ? static_cast<remove_cv_ref<T>>(std::forward<Func>(f)(value())) :
+                                 static_cast<remove_cv_ref<T>>(std::forward<T>(t));
         }
 
         /// \returns If the optional is not empty, `std::forward<Func>(f)(std::move(value()))` converted to the type `T` without cv or references.
@@ -617,8 +829,16 @@ namespace type_safe
             static const bool value = decltype(test<typename std::decay<T>::type>(0))::value;
         };
 
+        // SFINAE check that all types are optionals,
+        // so visit() does not hide overloads for other types
+        template <class... Optionals>
+        auto check_optionals(Optionals&&... optionals) -> decltype(
+            std::initializer_list<int>{((void)optionals.has_value(),
+                                        (void)std::forward<Optionals>(optionals).value(), 0)...});
+
+        // not named visit(), as detail is an associated namespace of basic_optional
         template <typename Visitor, class... Optionals>
-        auto visit(Visitor&& visitor, Optionals&&... optionals) -> decltype(
+        auto visit_impl(Visitor&& visitor, Optionals&&... optionals) -> decltype(
             detail::visit_optional<!visitor_allow_incomplete<Visitor>::value,
                                    decltype(std::forward<Visitor>(visitor)),
                                    decltype(std::forward<Optionals>(
@@ -644,12 +864,14 @@ namespace type_safe
     /// \returns The result of the chosen `operator()`,
     /// it's the type is the common type of all possible combinations.
     /// \notes An `Optional` here is every type with functions named `has_value()` and `value()`.
-    template <typename Visitor, class... Optionals>
+    template <typename Visitor, class... Optionals,
+              typename = decltype(detail::check_optionals(std::declval<Optionals>()...))>
     auto visit(Visitor&& visitor, Optionals&&... optionals)
-        -> decltype(detail::visit(std::forward<Visitor>(visitor),
-                                  std::forward<Optionals>(optionals)...))
+        -> decltype(detail::visit_impl(std::forward<Visitor>(visitor),
+                                       std::forward<Optionals>(optionals)...))
     {
-        return detail::visit(std::forward<Visitor>(visitor), std::forward<Optionals>(optionals)...);
+        return detail::visit_impl(std::forward<Visitor>(visitor),
+                                  std::forward<Optionals>(optionals)...);
     }
 
     /// \exclude
@@ -681,12 +903,12 @@ namespace type_safe
 
 #define TYPE_SAFE_DETAIL_MAKE_OP(Op, Expr, Expr2)                                                  \
     template <class StoragePolicy>                                                                 \
-    bool operator Op(const basic_optional<StoragePolicy>& lhs, nullopt_t)                          \
+    constexpr bool operator Op(const basic_optional<StoragePolicy>& lhs, nullopt_t)                \
     {                                                                                              \
         return (void)lhs, Expr;                                                                    \
     }                                                                                              \
     template <class StoragePolicy>                                                                 \
-    bool operator Op(nullopt_t, const basic_optional<StoragePolicy>& rhs)                          \
+    constexpr bool operator Op(nullopt_t, const basic_optional<StoragePolicy>& rhs)                \
     {                                                                                              \
         return (void)rhs, Expr2;                                                                   \
     }
@@ -708,15 +930,15 @@ namespace type_safe
 
 #define TYPE_SAFE_DETAIL_MAKE_OP(Op, Expr, Expr2)                                                  \
     template <class StoragePolicy>                                                                 \
-    auto operator Op(const basic_optional<StoragePolicy>&      lhs,                                \
-                     const typename StoragePolicy::value_type& rhs)                                \
+    constexpr auto operator Op(const basic_optional<StoragePolicy>&      lhs,                      \
+                               const typename StoragePolicy::value_type& rhs)                      \
         ->decltype(lhs.value() Op rhs)                                                             \
     {                                                                                              \
         return Expr;                                                                               \
     }                                                                                              \
     template <class StoragePolicy>                                                                 \
-    auto operator Op(const typename StoragePolicy::value_type& lhs,                                \
-                     const basic_optional<StoragePolicy>&      rhs)                                \
+    constexpr auto operator Op(const typename StoragePolicy::value_type& lhs,                      \
+                               const basic_optional<StoragePolicy>&      rhs)                      \
         ->decltype(lhs Op rhs.value())                                                             \
     {                                                                                              \
         return Expr2;                                                                              \
@@ -747,8 +969,8 @@ namespace type_safe
 
 #define TYPE_SAFE_DETAIL_MAKE_OP(Op)                                                               \
     template <class StoragePolicy>                                                                 \
-    auto operator Op(const basic_optional<StoragePolicy>& lhs,                                     \
-                     const basic_optional<StoragePolicy>& rhs)                                     \
+    constexpr auto operator Op(const basic_optional<StoragePolicy>& lhs,                           \
+                               const basic_optional<StoragePolicy>& rhs)                           \
         ->decltype(lhs.value() Op rhs.value())                                                     \
     {                                                                                              \
         return lhs.has_value() ? lhs.value() Op rhs : nullopt Op rhs;                              \
@@ -904,6 +1126,551 @@ namespace type_safe
         return result;
     }
 
+    //=== sentinel optional ===//
+    /// A `Sentinel` for [type_safe::sentinel_optional_storage<T, Sentinel>]()
+    /// that uses the constant `Value` to mark the empty state, e.g. `-1` or `nullptr`.
+    template <typename T, T Value>
+    struct value_sentinel
+    {
+        static constexpr T value() noexcept
+        {
+            return Value;
+        }
+
+        static constexpr bool is_sentinel(const T& t) noexcept
+        {
+            return t == Value;
+        }
+    };
+
+    /// A `Sentinel` for [type_safe::sentinel_optional_storage<T, Sentinel>]()
+    /// that uses a quiet NaN to mark the empty state of a floating point type.
+    /// \notes Every NaN is treated as the sentinel, so an optional with a value cannot contain NaN.
+    template <typename T>
+    struct nan_sentinel
+    {
+        static_assert(std::numeric_limits<T>::has_quiet_NaN, "T must have a NaN");
+
+        static constexpr T value() noexcept
+        {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+
+        static constexpr bool is_sentinel(const T& t) noexcept
+        {
+            return t != t;
+        }
+    };
+
+    /// A `StoragePolicy` for [type_safe::basic_optional<StoragePolicy>]() that marks the empty state
+    /// with a reserved value of `T` instead of a `bool` flag,
+    /// so the optional has the same size as `T`.
+    ///
+    /// The `Sentinel` must provide a `static` function `value()` returning the reserved value
+    /// and a `static` function `is_sentinel(const T&)` returning whether a value is the reserved one,
+    /// see [type_safe::value_sentinel<T, Value>]() and [type_safe::nan_sentinel<T>]().
+    /// \requires `T` must not be a reference, must be trivially destructible
+    /// and nothrow move constructible.
+    /// \notes `rebind<U>` is a [type_safe::direct_optional_storage<T>](),
+    /// as the result of `map()` could be the reserved value.
+    template <typename T, class Sentinel>
+    class sentinel_optional_storage
+    {
+        static_assert(!std::is_reference<T>::value,
+                      "T must not be a reference; use optional_ref<T> for that");
+        static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible");
+        static_assert(std::is_nothrow_move_constructible<T>::value,
+                      "T must be nothrow move constructible");
+
+    public:
+        using value_type             = typename std::remove_cv<T>::type;
+        using lvalue_reference       = T&;
+        using const_lvalue_reference = const T&;
+        using rvalue_reference       = T&&;
+        using const_rvalue_reference = const T&&;
+
+        template <typename U>
+        using rebind = direct_optional_storage<U>;
+
+        /// \effects Initializes it in the state without value,
+        /// i.e. stores the reserved value.
+        sentinel_optional_storage() noexcept : value_(Sentinel::value())
+        {
+        }
+
+        /// \effects Calls the constructor of `value_type` by perfectly forwarding `args`.
+        /// Afterwards `has_value()` will return `true`.
+        /// \throws Anything thrown by the constructor of `value_type` in which case `has_value()` is still `false`.
+        /// \requires `has_value() == false` and the created value must not be the reserved value.
+        /// \notes This function does not participate in overload resolution unless `value_type` is constructible from `args`.
+        template <typename... Args>
+        auto create_value(Args&&... args) ->
+            typename std::enable_if<std::is_constructible<value_type, Args&&...>::value>::type
+        {
+            // create it separately, so the storage is still empty if the constructor throws
+            value_type value(std::forward<Args>(args)...);
+            DEBUG_ASSERT(!Sentinel::is_sentinel(value), detail::assert_handler{},
+                         "cannot store the value reserved for the empty state");
+            ::new (static_cast<void*>(&value_)) value_type(std::move(value));
+        }
+
+        /// \effects Stores the reserved value.
+        /// Afterwards `has_value()` will return `false`.
+        /// \requires `has_value() == true`.
+        void destroy_value() noexcept
+        {
+            ::new (static_cast<void*>(&value_)) value_type(Sentinel::value());
+        }
+
+        /// \returns Whether or not there is a value stored,
+        /// i.e. the stored value is not the reserved value.
+        bool has_value() const noexcept
+        {
+            return !Sentinel::is_sentinel(value_);
+        }
+
+        /// \returns A reference to the stored value.
+        /// \requires `has_value() == true`.
+        lvalue_reference get_value() & noexcept
+        {
+            return value_;
+        }
+
+        /// \returns A `const` reference to the stored value.
+        /// \requires `has_value() == true`.
+        const_lvalue_reference get_value() const& noexcept
+        {
+            return value_;
+        }
+
+        /// \returns A reference to the stored value.
+        /// \requires `has_value() == true`.
+        rvalue_reference get_value() && noexcept
+        {
+            return std::move(value_);
+        }
+
+        /// \returns A `const` reference to the stored value.
+        /// \requires `has_value() == true`.
+        const_rvalue_reference get_value() const&& noexcept
+        {
+            return std::move(value_);
+        }
+
+        /// \returns Either `get_value()` or `u` converted to `value_type`.
+        /// \requires `value_type` must be copy constructible and `u` convertible to `value_type`.
+        template <typename U,
+                  typename =
+                      typename std::enable_if<std::is_copy_constructible<value_type>::value
+                                              && std::is_convertible<U&&, value_type>::value>::type>
+        value_type get_value_or(U&& u) const&
+        {
+            return has_value() ? get_value() : static_cast<value_type>(std::forward<U>(u));
+        }
+
+        /// \returns Either `std::move(get_value())` or `u` converted to `value_type`.
+        /// \requires `value_type` must be move constructible and `u` convertible to `value_type`.
+        template <typename U,
+                  typename =
+                      typename std::enable_if<std::is_move_constructible<value_type>::value
+                                              && std::is_convertible<U&&, value_type>::value>::type>
+        value_type get_value_or(U&& u) &&
+        {
+            return has_value() ? std::move(get_value()) :
+                                 static_cast<value_type>(std::forward<U>(u));
+        }
+
+    private:
+        value_type value_;
+    };
+
+    /// A [type_safe::basic_optional<StoragePolicy>]() that use [type_safe::sentinel_optional_storage<T, Sentinel>]().
+    /// It has the same size as `T`.
+    template <typename T, class Sentinel>
+    using sentinel_optional = basic_optional<sentinel_optional_storage<T, Sentinel>>;
+
+    //=== constexpr optional ===//
+    /// A `StoragePolicy` for [type_safe::basic_optional<StoragePolicy>]() that can be used in constant expressions.
+    ///
+    /// It stores the value in a `union` instead of [std::aligned_storage]()
+    /// and a `bool` flag whether a value was created.
+    /// It can be constructed with a value, so an optional using it can be created with a value,
+    /// and `has_value()`, `value()`, `value_or()`, `map()`, `transform()` and the comparisons can be evaluated at compile-time,
+    /// e.g. to create lookup tables without any initialization at runtime.
+    /// \requires `T` must not be a reference and must be trivially destructible.
+    /// \notes `rebind<U>` is a [type_safe::direct_optional_storage<T>]() if `U` is not trivially destructible.
+    /// \notes Only the `const` member functions are `constexpr`, as they are implicitly `const` in C++11,
+    /// so `value()` of a temporary optional cannot be used in a constant expression, but the comparisons can.
+    template <typename T>
+    class constexpr_optional_storage
+    {
+        static_assert(!std::is_reference<T>::value,
+                      "T must not be a reference; use optional_ref<T> for that");
+        static_assert(std::is_trivially_destructible<T>::value, "T must be trivially destructible");
+
+    public:
+        using value_type             = typename std::remove_cv<T>::type;
+        using lvalue_reference       = T&;
+        using const_lvalue_reference = const T&;
+        using rvalue_reference       = T&&;
+        using const_rvalue_reference = const T&&;
+
+        template <typename U>
+        using rebind = typename std::conditional<std::is_trivially_destructible<U>::value,
+                                                 constexpr_optional_storage<U>,
+                                                 direct_optional_storage<U>>::type;
+
+        /// \effects Initializes it in the state without value.
+        constexpr constexpr_optional_storage() noexcept : empty_(), has_value_(false)
+        {
+        }
+
+        /// \effects Initializes it with a value created by perfectly forwarding `value`.
+        /// Afterwards `has_value()` will return `true`.
+        /// \throws Anything thrown by the constructor of `value_type`.
+        /// \notes This constructor does not participate in overload resolution unless `value_type` is constructible from `value`.
+        template <typename U, typename = typename std::enable_if<
+                                  std::is_constructible<value_type, U&&>::value>::type>
+        explicit constexpr constexpr_optional_storage(U&& value)
+        : value_(std::forward<U>(value)), has_value_(true)
+        {
+        }
+
+        /// \effects Calls the constructor of `value_type` by perfectly forwarding `args`.
+        /// Afterwards `has_value()` will return `true`.
+        /// \throws Anything thrown by the constructor of `value_type` in which case `has_value()` is still `false`.
+        /// \requires `has_value() == false`.
+        /// \notes This function does not participate in overload resolution unless `value_type` is constructible from `args`.
+        template <typename... Args>
+        auto create_value(Args&&... args) ->
+            typename std::enable_if<std::is_constructible<value_type, Args&&...>::value>::type
+        {
+            ::new (static_cast<void*>(&value_)) value_type(std::forward<Args>(args)...);
+            has_value_ = true;
+        }
+
+        /// \effects Afterwards `has_value()` will return `false`,
+        /// the value does not need to be destroyed.
+        /// \requires `has_value() == true`.
+        void destroy_value() noexcept
+        {
+            has_value_ = false;
+        }
+
+        /// \returns Whether or not there is a value stored.
+        constexpr bool has_value() const noexcept
+        {
+            return has_value_;
+        }
+
+        /// \returns A reference to the stored value.
+        /// \requires `has_value() == true`.
+        lvalue_reference get_value() & noexcept
+        {
+            return value_;
+        }
+
+        /// \returns A `const` reference to the stored value.
+        /// \requires `has_value() == true`.
+        constexpr const_lvalue_reference get_value() const& noexcept
+        {
+            return value_;
+        }
+
+        /// \returns A reference to the stored value.
+        /// \requires `has_value() == true`.
+        rvalue_reference get_value() && noexcept
+        {
+            return std::move(value_);
+        }
+
+        /// \returns A `const` reference to the stored value.
+        /// \requires `has_value() == true`.
+        constexpr const_rvalue_reference get_value() const&& noexcept
+        {
+            return std::move(value_);
+        }
+
+        /// \returns Either `get_value()` or `u` converted to `value_type`.
+        /// \requires `value_type` must be copy constructible and `u` convertible to `value_type`.
+        template <typename U,
+                  typename =
+                      typename std::enable_if<std::is_copy_constructible<value_type>::value
+                                              && std::is_convertible<U&&, value_type>::value>::type>
+        constexpr value_type get_value_or(U&& u) const&
+        {
+            return has_value() ? value_ : static_cast<value_type>(std::forward<U>(u));
+        }
+
+        /// \returns Either `std::move(get_value())` or `u` converted to `value_type`.
+        /// \requires `value_type` must be move constructible and `u` convertible to `value_type`.
+        template <typename U,
+                  typename =
+                      typename std::enable_if<std::is_move_constructible<value_type>::value
+                                              && std::is_convertible<U&&, value_type>::value>::type>
+        value_type get_value_or(U&& u) &&
+        {
+            return has_value() ? std::move(value_) : static_cast<value_type>(std::forward<U>(u));
+        }
+
+    private:
+        struct empty_t
+        {
+        };
+
+        union
+        {
+            empty_t    empty_;
+            value_type value_;
+        };
+        bool has_value_;
+    };
+
+    /// A [type_safe::basic_optional<StoragePolicy>]() that use [type_safe::constexpr_optional_storage<T>]().
+    /// It can be used in constant expressions.
+    template <typename T>
+    using constexpr_optional = basic_optional<constexpr_optional_storage<T>>;
+
+    //=== polymorphic optional ===//
+    /// \exclude
+    namespace detail
+    {
+        enum class polymorphic_operation
+        {
+            copy,
+            move,
+            destroy,
+        };
+
+        // copies/moves the T at src to dest and returns the Base of the new object,
+        // or destroys the T at src
+        template <class Base, typename T>
+        Base* polymorphic_manage(polymorphic_operation op, void* dest, void* src)
+        {
+            switch (op)
+            {
+            case polymorphic_operation::copy:
+                return ::new (dest) T(*static_cast<const T*>(src));
+            case polymorphic_operation::move:
+                return ::new (dest) T(std::move(*static_cast<T*>(src)));
+            case polymorphic_operation::destroy:
+                static_cast<T*>(src)->~T();
+                return nullptr;
+            }
+            DEBUG_UNREACHABLE(detail::assert_handler{});
+            return nullptr;
+        }
+
+        // whether Args is a single object of a type derived from Base
+        template <class Base, typename... Args>
+        struct is_derived_argument : std::false_type
+        {
+        };
+
+        template <class Base, typename Arg>
+        struct is_derived_argument<Base, Arg>
+        : std::is_base_of<Base, typename std::decay<Arg>::type>
+        {
+        };
+    } // namespace detail
+
+    /// A `StoragePolicy` for [type_safe::basic_optional<StoragePolicy>]() that stores objects of any type derived from `Base`
+    /// in an inline buffer of `Size` bytes with the given `Alignment`.
+    ///
+    /// `value()` returns a reference to the `Base` of the stored object, so virtual functions dispatch to the stored type,
+    /// and copying or moving the optional copies or moves the stored type, without a heap allocation.
+    /// Creating it from a single object of a type derived from `Base` stores a copy of that type,
+    /// creating it from other arguments forwards them to the constructor of `Base`.
+    /// \requires `Base` must not be a reference.
+    /// The stored types must be copy and move constructible, at most `Size` bytes big
+    /// and their alignment must divide `Alignment`, otherwise creating them is a compile-time error.
+    /// \notes `value_or()` is not supported, as it would slice the value,
+    /// and `rebind<U>` is a [type_safe::direct_optional_storage<T>]().
+    template <class Base, std::size_t Size = sizeof(Base), std::size_t Alignment = alignof(Base)>
+    class polymorphic_optional_storage
+    {
+        static_assert(!std::is_reference<Base>::value,
+                      "Base must not be a reference; use optional_ref<T> for that");
+
+        using manager = Base* (*)(detail::polymorphic_operation, void*, void*);
+
+    public:
+        using value_type             = typename std::remove_cv<Base>::type;
+        using lvalue_reference       = Base&;
+        using const_lvalue_reference = const Base&;
+        using rvalue_reference       = Base&&;
+        using const_rvalue_reference = const Base&&;
+
+        template <typename U>
+        using rebind = direct_optional_storage<U>;
+
+        using copies_value = void;
+
+        /// \effects Initializes it in the state without value.
+        polymorphic_optional_storage() noexcept : value_(nullptr), manage_(nullptr)
+        {
+        }
+
+        /// \effects Creates it with a copy of the stored object of `other`, if it has one.
+        /// \throws Anything thrown by the copy constructor of the stored type.
+        polymorphic_optional_storage(const polymorphic_optional_storage& other)
+        : polymorphic_optional_storage()
+        {
+            copy_from(detail::polymorphic_operation::copy, other);
+        }
+
+        /// \effects Creates it with the stored object of `other` moved, if it has one.
+        /// \throws Anything thrown by the move constructor of the stored type.
+        /// \notes `other` will still have a value, it is just in a moved-from state.
+        polymorphic_optional_storage(polymorphic_optional_storage&& other)
+        : polymorphic_optional_storage()
+        {
+            copy_from(detail::polymorphic_operation::move, other);
+        }
+
+        /// \effects Destroys the stored object, if there is any.
+        ~polymorphic_optional_storage() noexcept
+        {
+            if (has_value())
+                destroy_value();
+        }
+
+        /// \effects Destroys the stored object, if there is any,
+        /// and creates a copy of the stored object of `other`, if it has one.
+        /// \throws Anything thrown by the copy constructor of the stored type,
+        /// it does not have a value then.
+        polymorphic_optional_storage& operator=(const polymorphic_optional_storage& other)
+        {
+            if (this != &other)
+            {
+                if (has_value())
+                    destroy_value();
+                copy_from(detail::polymorphic_operation::copy, other);
+            }
+            return *this;
+        }
+
+        /// \effects Destroys the stored object, if there is any,
+        /// and moves the stored object of `other`, if it has one.
+        /// \throws Anything thrown by the move constructor of the stored type,
+        /// it does not have a value then.
+        polymorphic_optional_storage& operator=(polymorphic_optional_storage&& other)
+        {
+            if (this != &other)
+            {
+                if (has_value())
+                    destroy_value();
+                copy_from(detail::polymorphic_operation::move, other);
+            }
+            return *this;
+        }
+
+        /// \effects Stores a copy of `value` with its decayed type.
+        /// Afterwards `has_value()` will return `true`.
+        /// \throws Anything thrown by the constructor of the decayed type in which case `has_value()` is still `false`.
+        /// \requires `has_value() == false`.
+        /// \notes This function does not participate in overload resolution unless the decayed type is derived from `Base`,
+        /// or is `Base` itself.
+        template <typename T>
+        auto create_value(T&& value) ->
+            typename std::enable_if<detail::is_derived_argument<Base, T>::value>::type
+        {
+            using type = typename std::decay<T>::type;
+            static_assert(sizeof(type) <= Size, "type is too big for the buffer");
+            static_assert(Alignment % alignof(type) == 0u,
+                          "type has an alignment not supported by the buffer");
+
+            value_  = ::new (static_cast<void*>(&storage_)) type(std::forward<T>(value));
+            manage_ = &detail::polymorphic_manage<Base, type>;
+        }
+
+        /// \effects Calls the constructor of `Base` by perfectly forwarding `args`.
+        /// Afterwards `has_value()` will return `true`.
+        /// \throws Anything thrown by the constructor of `Base` in which case `has_value()` is still `false`.
+        /// \requires `has_value() == false`.
+        /// \notes This function does not participate in overload resolution unless `Base` is constructible from `args`,
+        /// and `args` is not a single object of a type derived from `Base`.
+        template <typename... Args>
+        auto create_value(Args&&... args) ->
+            typename std::enable_if<!detail::is_derived_argument<Base, Args...>::value
+                                    && std::is_constructible<value_type, Args&&...>::value>::type
+        {
+            value_  = ::new (static_cast<void*>(&storage_)) value_type(std::forward<Args>(args)...);
+            manage_ = &detail::polymorphic_manage<Base, value_type>;
+        }
+
+        /// \effects Calls the destructor of the stored object.
+        /// Afterwards `has_value()` will return `false`.
+        /// \requires `has_value() == true`.
+        void destroy_value() noexcept
+        {
+            manage_(detail::polymorphic_operation::destroy, nullptr, &storage_);
+            value_  = nullptr;
+            manage_ = nullptr;
+        }
+
+        /// \returns Whether or not there is an object stored.
+        bool has_value() const noexcept
+        {
+            return value_ != nullptr;
+        }
+
+        /// \notes Not supported, as the result would be sliced.
+        template <typename U>
+        void get_value_or(U&&) const = delete;
+
+        /// \returns A reference to the `Base` of the stored object.
+        /// \requires `has_value() == true`.
+        lvalue_reference get_value() & noexcept
+        {
+            return *value_;
+        }
+
+        /// \returns A `const` reference to the `Base` of the stored object.
+        /// \requires `has_value() == true`.
+        const_lvalue_reference get_value() const& noexcept
+        {
+            return *value_;
+        }
+
+        /// \returns An rvalue reference to the `Base` of the stored object.
+        /// \requires `has_value() == true`.
+        rvalue_reference get_value() && noexcept
+        {
+            return std::move(*value_);
+        }
+
+        /// \returns A `const` rvalue reference to the `Base` of the stored object.
+        /// \requires `has_value() == true`.
+        const_rvalue_reference get_value() const&& noexcept
+        {
+            return std::move(*value_);
+        }
+
+    private:
+        // the Base may not be at the beginning of the stored type, so store a pointer to it
+        void copy_from(detail::polymorphic_operation op, const polymorphic_optional_storage& other)
+        {
+            if (other.has_value())
+            {
+                // only moving modifies the object of other
+                auto object = const_cast<void*>(static_cast<const void*>(&other.storage_));
+                value_      = other.manage_(op, &storage_, object);
+                manage_     = other.manage_;
+            }
+        }
+
+        typename std::aligned_storage<Size, Alignment>::type storage_;
+        Base*                                                value_;
+        manager                                              manage_;
+    };
+
+    /// A [type_safe::basic_optional<StoragePolicy>]() that uses [type_safe::polymorphic_optional_storage<Base, Size, Alignment>]().
+    /// It can store any type derived from `Base` that fits into `Size` bytes, without a heap allocation.
+    template <class Base, std::size_t Size = sizeof(Base), std::size_t Alignment = alignof(Base)>
+    using polymorphic_optional =
+        basic_optional<polymorphic_optional_storage<Base, Size, Alignment>>;
+
     //=== optional reference ===//
     /// A `StoragePolicy` for [type_safe::basic_optional<StoragePolicy>]() that allows optional references.
     ///
@@ -0,0 +1,354 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_OPTIONAL_PIPELINE_HPP_INCLUDED
+#define TYPE_SAFE_OPTIONAL_PIPELINE_HPP_INCLUDED
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/optional.hpp>
+
+namespace type_safe
+{
+    /// \exclude
+    namespace detail
+    {
+        //=== steps ===//
+        // a step calls cont(value) to continue with a value or returns cont.empty()
+        struct pipeline_step
+        {
+        };
+
+        template <typename Func>
+        struct map_step : pipeline_step
+        {
+            explicit map_step(Func f) : func(std::move(f))
+            {
+            }
+
+            template <typename T>
+            using result = decltype(std::declval<Func&>()(std::declval<T>()));
+
+            template <class Continuation, typename T>
+            auto run(const Continuation& cont, T&& value) -> decltype(cont.empty())
+            {
+                return cont(func(std::forward<T>(value)));
+            }
+
+            Func func;
+        };
+
+        template <typename Predicate>
+        struct filter_step : pipeline_step
+        {
+            explicit filter_step(Predicate p) : predicate(std::move(p))
+            {
+            }
+
+            template <typename T>
+            using result = T;
+
+            template <class Continuation, typename T>
+            auto run(const Continuation& cont, T&& value) -> decltype(cont.empty())
+            {
+                return predicate(static_cast<const typename std::remove_reference<T>::type&>(
+                           value)) ?
+                           cont(std::forward<T>(value)) :
+                           cont.empty();
+            }
+
+            Predicate predicate;
+        };
+
+        template <typename Func>
+        struct bind_step : pipeline_step
+        {
+            explicit bind_step(Func f) : func(std::move(f))
+            {
+            }
+
+            template <typename T>
+            using optional_result =
+                typename std::decay<decltype(std::declval<Func&>()(std::declval<T>()))>::type;
+
+            template <typename T>
+            using result = decltype(std::declval<optional_result<T>>().value());
+
+            template <class Continuation, typename T>
+            auto run(const Continuation& cont, T&& value) -> decltype(cont.empty())
+            {
+                optional_result<T&&> opt = func(std::forward<T>(value));
+                return opt.has_value() ? cont(std::move(opt).value()) : cont.empty();
+            }
+
+            Func func;
+        };
+
+        template <typename T, class... Steps>
+        struct pipeline_result
+        {
+            using type = T;
+        };
+
+        template <typename T, class Step, class... Rest>
+        struct pipeline_result<T, Step, Rest...>
+        : pipeline_result<typename Step::template result<T>, Rest...>
+        {
+        };
+
+        //=== terminals ===//
+        // a terminal creates a sink that receives the final value or the empty state
+        struct pipeline_terminal
+        {
+        };
+
+        template <typename U>
+        struct value_or_terminal : pipeline_terminal
+        {
+            explicit value_or_terminal(U u) : fallback(std::move(u))
+            {
+            }
+
+            template <typename T, class Optional>
+            struct sink
+            {
+                using result_type = typename std::decay<T>::type;
+
+                template <typename V>
+                result_type value(V&& v) const
+                {
+                    return static_cast<result_type>(std::forward<V>(v));
+                }
+
+                result_type empty() const
+                {
+                    return static_cast<result_type>(std::move(terminal.fallback));
+                }
+
+                value_or_terminal& terminal;
+            };
+
+            template <typename T, class Optional>
+            sink<T, Optional> make_sink()
+            {
+                return {*this};
+            }
+
+            U fallback;
+        };
+
+        struct to_optional_terminal : pipeline_terminal
+        {
+            template <typename T, class Optional>
+            struct sink
+            {
+                using result_type =
+                    typename Optional::template rebind<typename std::decay<T>::type>;
+
+                template <typename V>
+                result_type value(V&& v) const
+                {
+                    return result_type(std::forward<V>(v));
+                }
+
+                result_type empty() const
+                {
+                    return result_type(nullopt);
+                }
+            };
+
+            template <typename T, class Optional>
+            sink<T, Optional> make_sink()
+            {
+                return {};
+            }
+        };
+
+        template <typename T>
+        using is_pipeline_step = std::is_base_of<pipeline_step, typename std::decay<T>::type>;
+
+        template <typename T>
+        using is_pipeline_terminal =
+            std::is_base_of<pipeline_terminal, typename std::decay<T>::type>;
+
+        template <class Pipeline, std::size_t I, class Sink>
+        struct pipeline_continuation
+        {
+            template <typename T>
+            typename Sink::result_type operator()(T&& value) const
+            {
+                return pipeline.template run<I>(sink, std::forward<T>(value));
+            }
+
+            typename Sink::result_type empty() const
+            {
+                return sink.empty();
+            }
+
+            Pipeline& pipeline;
+            Sink&     sink;
+        };
+    } // namespace detail
+
+    /// A lazy sequence of operations on a [type_safe::basic_optional<StoragePolicy>]().
+    ///
+    /// It is created by applying [type_safe::pipeline::map()](), [type_safe::pipeline::filter()]()
+    /// or [type_safe::pipeline::bind()]() to an optional with `operator|`
+    /// and evaluated by applying [type_safe::pipeline::value_or()]() or [type_safe::pipeline::to_optional()]().
+    /// Unlike the member functions of the optional,
+    /// the operations are fused: it checks for a value once,
+    /// passes the value directly from one function to the next
+    /// and only creates the final result, no intermediate optionals.
+    /// \notes It stores a reference to an lvalue optional, which must outlive it,
+    /// but an rvalue optional is moved into it, so it does not dangle if it is evaluated later.
+    template <class Optional, class... Steps>
+    class optional_pipeline
+    {
+        using optional_type = typename std::decay<Optional>::type;
+        using value_type    = typename detail::
+            pipeline_result<decltype(std::declval<Optional>().value()), Steps...>::type;
+
+    public:
+        /// \exclude
+        optional_pipeline(Optional&& opt, std::tuple<Steps...>&& steps)
+        : optional_(std::forward<Optional>(opt)), steps_(std::move(steps))
+        {
+        }
+
+        /// \returns A new pipeline with the additional `step`.
+        template <class Step, typename = typename std::enable_if<
+                                  detail::is_pipeline_step<Step>::value>::type>
+        friend optional_pipeline<Optional, Steps..., typename std::decay<Step>::type> operator|(
+            optional_pipeline&& pipeline, Step&& step)
+        {
+            return {std::forward<Optional>(pipeline.optional_),
+                    std::tuple_cat(std::move(pipeline.steps_),
+                                   std::make_tuple(std::forward<Step>(step)))};
+        }
+
+        /// \effects Evaluates the pipeline.
+        /// \returns The result of the `terminal`.
+        template <class Terminal, typename = typename std::enable_if<
+                                      detail::is_pipeline_terminal<Terminal>::value>::type>
+        friend auto operator|(optional_pipeline&& pipeline, Terminal&& terminal) ->
+            typename decltype(terminal.template make_sink<value_type, optional_type>())::result_type
+        {
+            auto  sink = terminal.template make_sink<value_type, optional_type>();
+            auto& opt  = pipeline.optional_;
+            return opt.has_value() ?
+                       pipeline.template run<0>(sink, std::forward<Optional>(opt).value()) :
+                       sink.empty();
+        }
+
+    private:
+        template <std::size_t I, class Sink, typename T>
+        typename Sink::result_type run(Sink& sink, T&& value)
+        {
+            return run<I>(std::integral_constant<bool, I == sizeof...(Steps)>{}, sink,
+                          std::forward<T>(value));
+        }
+
+        template <std::size_t I, class Sink, typename T>
+        typename Sink::result_type run(std::true_type, Sink& sink, T&& value)
+        {
+            return sink.value(std::forward<T>(value));
+        }
+
+        template <std::size_t I, class Sink, typename T>
+        typename Sink::result_type run(std::false_type, Sink& sink, T&& value)
+        {
+            using continuation = detail::pipeline_continuation<optional_pipeline, I + 1, Sink>;
+            return std::get<I>(steps_).run(continuation{*this, sink}, std::forward<T>(value));
+        }
+
+        Optional             optional_; // a reference for lvalues, a value for rvalues
+        std::tuple<Steps...> steps_;
+
+        template <class, std::size_t, class>
+        friend struct detail::pipeline_continuation;
+    };
+
+    /// \returns A [type_safe::optional_pipeline<Optional, Steps...>]() with the single `step`.
+    /// \notes This function does not participate in overload resolution,
+    /// unless `Optional` is a [type_safe::basic_optional<StoragePolicy>]()
+    /// and `step` was created by [type_safe::pipeline::map()](), [type_safe::pipeline::filter()]()
+    /// or [type_safe::pipeline::bind()]().
+    template <class Optional, class Step,
+              typename = typename std::enable_if<detail::is_optional<Optional>::value
+                                                 && detail::is_pipeline_step<Step>::value>::type>
+    optional_pipeline<Optional, typename std::decay<Step>::type> operator|(Optional&& opt,
+                                                                         Step&&     step)
+    {
+        return {std::forward<Optional>(opt), std::make_tuple(std::forward<Step>(step))};
+    }
+
+    /// \returns The result of the `terminal` applied to the optional,
+    /// i.e. a pipeline without any steps.
+    /// \notes This function does not participate in overload resolution,
+    /// unless `Optional` is a [type_safe::basic_optional<StoragePolicy>]()
+    /// and `terminal` was created by [type_safe::pipeline::value_or()]()
+    /// or [type_safe::pipeline::to_optional()]().
+    template <class Optional, class Terminal,
+              typename = typename std::enable_if<
+                  detail::is_optional<Optional>::value
+                  && detail::is_pipeline_terminal<Terminal>::value>::type>
+    auto operator|(Optional&& opt, Terminal&& terminal)
+        -> decltype(optional_pipeline<Optional>(std::forward<Optional>(opt), std::tuple<>{})
+                    | std::forward<Terminal>(terminal))
+    {
+        return optional_pipeline<Optional>(std::forward<Optional>(opt), std::tuple<>{})
+               | std::forward<Terminal>(terminal);
+    }
+
+    // the steps and terminals, in a separate namespace so they do not collide with std::bind() etc.
+    namespace pipeline
+    {
+        /// \returns A step for an [type_safe::optional_pipeline<Optional, Steps...>]()
+        /// that replaces the value by `f(value)`, like `map()` of the optional.
+        template <typename Func>
+        detail::map_step<typename std::decay<Func>::type> map(Func&& f)
+        {
+            return detail::map_step<typename std::decay<Func>::type>(std::forward<Func>(f));
+        }
+
+        /// \returns A step for an [type_safe::optional_pipeline<Optional, Steps...>]()
+        /// that continues with the value if `p(value)` returns `true`
+        /// and results in the empty state otherwise.
+        template <typename Predicate>
+        detail::filter_step<typename std::decay<Predicate>::type> filter(Predicate&& p)
+        {
+            return detail::filter_step<typename std::decay<Predicate>::type>(
+                std::forward<Predicate>(p));
+        }
+
+        /// \returns A step for an [type_safe::optional_pipeline<Optional, Steps...>]()
+        /// that replaces the value by the value of the optional `f(value)`,
+        /// or results in the empty state if it does not have one, like `bind()` of the optional.
+        template <typename Func>
+        detail::bind_step<typename std::decay<Func>::type> bind(Func&& f)
+        {
+            return detail::bind_step<typename std::decay<Func>::type>(std::forward<Func>(f));
+        }
+
+        /// \returns A terminal for an [type_safe::optional_pipeline<Optional, Steps...>]()
+        /// that evaluates it to the final value or `u` converted to its type, like `value_or()` of the optional.
+        template <typename U>
+        detail::value_or_terminal<typename std::decay<U>::type> value_or(U&& u)
+        {
+            return detail::value_or_terminal<typename std::decay<U>::type>(std::forward<U>(u));
+        }
+
+        /// \returns A terminal for an [type_safe::optional_pipeline<Optional, Steps...>]()
+        /// that evaluates it to an optional of the same kind containing the final value, if there is any.
+        inline detail::to_optional_terminal to_optional() noexcept
+        {
+            return {};
+        }
+    } // namespace pipeline
+} // namespace type_safe
+
+#endif // TYPE_SAFE_OPTIONAL_PIPELINE_HPP_INCLUDED
@@ -0,0 +1,612 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef TYPE_SAFE_OPTIONAL_VECTOR_HPP_INCLUDED
+#define TYPE_SAFE_OPTIONAL_VECTOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <type_safe/detail/assert.hpp>
+#include <type_safe/array_ref.hpp>
+#include <type_safe/optional.hpp>
+
+namespace type_safe
+{
+    /// \exclude
+    namespace detail
+    {
+        using bitmap_word = std::uint64_t;
+
+        constexpr std::size_t bitmap_word_bits = 64u;
+
+        constexpr std::size_t bitmap_word_count(std::size_t bits) noexcept
+        {
+            return (bits + bitmap_word_bits - 1u) / bitmap_word_bits;
+        }
+
+        // word with the lower `bits` bits set
+        constexpr bitmap_word bitmap_mask(std::size_t bits) noexcept
+        {
+            return bits >= bitmap_word_bits ? ~bitmap_word(0u) : (bitmap_word(1u) << bits) - 1u;
+        }
+
+        inline std::size_t popcount(bitmap_word word) noexcept
+        {
+#if defined(__GNUC__)
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+            word = word - ((word >> 1u) & 0x5555555555555555u);
+            word = (word & 0x3333333333333333u) + ((word >> 2u) & 0x3333333333333333u);
+            word = (word + (word >> 4u)) & 0x0f0f0f0f0f0f0f0fu;
+            return static_cast<std::size_t>((word * 0x0101010101010101u) >> 56u);
+#endif
+        }
+
+        struct optional_vector_access;
+    } // namespace detail
+
+    /// A sequence of optional values stored as a structure of arrays.
+    ///
+    /// The values are stored contiguously, as if in a [std::vector<T>](),
+    /// and whether or not an element has a value is tracked in a separate bitmap, one bit per element.
+    /// Unlike `std::vector<optional<T>>` it has no padding between the values,
+    /// and operations that only need the presence, like `count_present()`, only read the bitmap.
+    /// Element access returns a [type_safe::optional_ref<T>]() to the value.
+    /// \requires `T` must not be a reference and must be default constructible,
+    /// elements without a value store a default constructed `T`.
+    /// `T` must not be `bool`, as [std::vector<bool>]() does not store the values contiguously.
+    template <typename T>
+    class optional_vector
+    {
+        static_assert(!std::is_reference<T>::value, "T must not be a reference");
+        static_assert(std::is_default_constructible<T>::value, "T must be default constructible");
+        static_assert(!std::is_same<T, bool>::value,
+                      "T must not be bool, use optional_vector<unsigned char> instead");
+
+        template <typename U>
+        class iterator_impl
+        {
+        public:
+            using value_type        = optional_ref<U>;
+            using reference         = optional_ref<U>;
+            using pointer           = void;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::input_iterator_tag;
+
+            iterator_impl() noexcept : values_(nullptr), bitmap_(nullptr), index_(0u)
+            {
+            }
+
+            /// \effects Converts an `iterator` to a `const_iterator`.
+            template <typename V,
+                      typename = typename std::enable_if<std::is_same<const V, U>::value>::type>
+            iterator_impl(const iterator_impl<V>& other) noexcept
+            : values_(other.values_), bitmap_(other.bitmap_), index_(other.index_)
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return (bitmap_[index_ / detail::bitmap_word_bits]
+                        >> (index_ % detail::bitmap_word_bits))
+                               & 1u ?
+                           reference(values_[index_]) :
+                           reference(nullopt);
+            }
+
+            iterator_impl& operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            iterator_impl operator++(int) noexcept
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            friend bool operator==(const iterator_impl& a, const iterator_impl& b) noexcept
+            {
+                return a.index_ == b.index_;
+            }
+
+            friend bool operator!=(const iterator_impl& a, const iterator_impl& b) noexcept
+            {
+                return !(a == b);
+            }
+
+        private:
+            iterator_impl(U* values, const detail::bitmap_word* bitmap, std::size_t index) noexcept
+            : values_(values), bitmap_(bitmap), index_(index)
+            {
+            }
+
+            U*                         values_;
+            const detail::bitmap_word* bitmap_;
+            std::size_t                index_;
+
+            template <typename>
+            friend class iterator_impl;
+            friend optional_vector;
+        };
+
+    public:
+        using value_type      = T;
+        using reference       = optional_ref<T>;
+        using const_reference = optional_ref<const T>;
+        using iterator        = iterator_impl<T>;
+        using const_iterator  = iterator_impl<const T>;
+
+        //=== constructors ===//
+        /// \effects Creates it without any elements.
+        optional_vector() = default;
+
+        /// \effects Creates it with `size` elements without a value.
+        explicit optional_vector(std::size_t size)
+        : values_(size), bitmap_(detail::bitmap_word_count(size), 0u)
+        {
+        }
+
+        //=== modifiers ===//
+        /// \effects Reserves memory for at least `capacity` elements.
+        void reserve(std::size_t capacity)
+        {
+            values_.reserve(capacity);
+            bitmap_.reserve(detail::bitmap_word_count(capacity));
+        }
+
+        /// \effects Appends an element with a copy of `value`.
+        void push_back(const T& value)
+        {
+            prepare_push_back();
+            values_.push_back(value);
+            finish_push_back(true);
+        }
+
+        /// \effects Appends an element with `value` moved into it.
+        void push_back(T&& value)
+        {
+            prepare_push_back();
+            values_.push_back(std::move(value));
+            finish_push_back(true);
+        }
+
+        /// \effects Appends an element without a value.
+        void push_back(nullopt_t)
+        {
+            prepare_push_back();
+            values_.emplace_back();
+            finish_push_back(false);
+        }
+
+        /// \effects Gives the `i`th element a copy of `value`.
+        /// \requires `i < size()`.
+        void set_value(std::size_t i, const T& value)
+        {
+            DEBUG_ASSERT(i < size(), detail::assert_handler{}, "out of bounds");
+            values_[i] = value;
+            bitmap_[i / detail::bitmap_word_bits] |= bit(i);
+        }
+
+        /// \effects Gives the `i`th element `value` moved into it.
+        /// \requires `i < size()`.
+        void set_value(std::size_t i, T&& value)
+        {
+            DEBUG_ASSERT(i < size(), detail::assert_handler{}, "out of bounds");
+            values_[i] = std::move(value);
+            bitmap_[i / detail::bitmap_word_bits] |= bit(i);
+        }
+
+        /// \effects Removes the value of the `i`th element.
+        /// The stored value is not destroyed, but it is no longer accessible.
+        /// \requires `i < size()`.
+        void reset(std::size_t i) noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::assert_handler{}, "out of bounds");
+            bitmap_[i / detail::bitmap_word_bits] &= ~bit(i);
+        }
+
+        /// \effects Removes all elements.
+        void clear() noexcept
+        {
+            values_.clear();
+            bitmap_.clear();
+        }
+
+        //=== access ===//
+        /// \returns The number of elements, with or without value.
+        std::size_t size() const noexcept
+        {
+            return values_.size();
+        }
+
+        /// \returns Whether or not there are no elements.
+        bool empty() const noexcept
+        {
+            return values_.empty();
+        }
+
+        /// \returns Whether or not the `i`th element has a value.
+        /// \requires `i < size()`.
+        bool has_value(std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::assert_handler{}, "out of bounds");
+            return (bitmap_[i / detail::bitmap_word_bits] & bit(i)) != 0u;
+        }
+
+        /// \returns A [type_safe::optional_ref<T>]() to the value of the `i`th element,
+        /// or `nullopt` if it does not have one.
+        /// \requires `i < size()`.
+        reference operator[](std::size_t i) noexcept
+        {
+            return has_value(i) ? reference(values_[i]) : reference(nullopt);
+        }
+
+        /// \returns A [type_safe::optional_ref<T>]() to `const` to the value of the `i`th element,
+        /// or `nullopt` if it does not have one.
+        /// \requires `i < size()`.
+        const_reference operator[](std::size_t i) const noexcept
+        {
+            return has_value(i) ? const_reference(values_[i]) : const_reference(nullopt);
+        }
+
+        /// \returns A reference to the contiguous values of all elements.
+        /// \notes The value of an element without a value is unspecified,
+        /// use `has_value()` to check it.
+        array_ref<T> values() noexcept
+        {
+            return array_ref<T>(values_.data(), values_.size());
+        }
+
+        /// \returns A reference to `const` to the contiguous values of all elements.
+        /// \notes The value of an element without a value is unspecified,
+        /// use `has_value()` to check it.
+        array_ref<const T> values() const noexcept
+        {
+            return array_ref<const T>(values_.data(), values_.size());
+        }
+
+        /// \returns An iterator to the first element,
+        /// dereferencing it yields the same as `operator[]`.
+        iterator begin() noexcept
+        {
+            return iterator(values_.data(), bitmap_.data(), 0u);
+        }
+
+        /// \returns An iterator one past the last element.
+        iterator end() noexcept
+        {
+            return iterator(values_.data(), bitmap_.data(), size());
+        }
+
+        /// \returns A `const` iterator to the first element,
+        /// dereferencing it yields the same as `operator[]`.
+        const_iterator begin() const noexcept
+        {
+            return const_iterator(values_.data(), bitmap_.data(), 0u);
+        }
+
+        /// \returns A `const` iterator one past the last element.
+        const_iterator end() const noexcept
+        {
+            return const_iterator(values_.data(), bitmap_.data(), size());
+        }
+
+        //=== bulk operations ===//
+        /// \returns The number of elements with a value.
+        /// \notes It only reads the bitmap, 64 elements at a time.
+        std::size_t count_present() const noexcept
+        {
+            std::size_t result = 0u;
+            for (auto word : bitmap_)
+                result += detail::popcount(word);
+            return result;
+        }
+
+        /// \effects Gives every element without a value a copy of `value`,
+        /// afterwards all elements have a value.
+        /// \notes Groups of 64 elements that all have a value are skipped,
+        /// the other groups are filled by a loop that can be vectorized if `T` is trivially copyable.
+        void fill_missing(const T& value)
+        {
+            for (std::size_t w = 0u; w != detail::bitmap_word_count(size()); ++w)
+            {
+                auto first = w * detail::bitmap_word_bits;
+                auto count = word_size(first);
+                if (bitmap_[w] != detail::bitmap_mask(count))
+                    fill_word(std::is_trivially_copyable<T>{}, values_.data() + first, count,
+                              bitmap_[w], value);
+                bitmap_[w] = detail::bitmap_mask(count);
+            }
+        }
+
+        /// \returns An `optional_vector` of the same size,
+        /// whose `i`th element has the value `f(value)` if the `i`th element here has `value`,
+        /// or no value otherwise.
+        /// \requires `f` must be callable with `const T&` and return a default constructible type.
+        /// \notes `f` is only called for elements with a value,
+        /// but groups of 64 elements that all have a value are mapped without checking,
+        /// by a loop that can be vectorized.
+        template <typename Func>
+        auto map(Func&& f) const
+            -> optional_vector<typename std::decay<decltype(f(std::declval<const T&>()))>::type>
+        {
+            using result_type = typename std::decay<decltype(f(std::declval<const T&>()))>::type;
+
+            optional_vector<result_type> result(size());
+            for (std::size_t w = 0u; w != detail::bitmap_word_count(size()); ++w)
+            {
+                auto first = w * detail::bitmap_word_bits;
+                auto count = word_size(first);
+                auto word  = bitmap_[w];
+
+                auto in  = values_.data() + first;
+                auto out = result.values_.data() + first;
+                if (word == detail::bitmap_mask(count))
+                {
+                    for (std::size_t i = 0u; i != count; ++i)
+                        out[i] = f(in[i]);
+                }
+                else if (word != 0u)
+                {
+                    for (std::size_t i = 0u; i != count; ++i)
+                        if ((word >> i) & 1u)
+                            out[i] = f(in[i]);
+                }
+                result.bitmap_[w] = word;
+            }
+            return result;
+        }
+
+    private:
+        static detail::bitmap_word bit(std::size_t i) noexcept
+        {
+            return detail::bitmap_word(1u) << (i % detail::bitmap_word_bits);
+        }
+
+        // number of elements in the bitmap word starting at element `first`
+        std::size_t word_size(std::size_t first) const noexcept
+        {
+            return size() - first < detail::bitmap_word_bits ? size() - first :
+                                                               detail::bitmap_word_bits;
+        }
+
+        // the bitmap may have a spare zero word if a push_back() threw,
+        // but the bits of elements past the end are always zero
+        void prepare_push_back()
+        {
+            if (bitmap_.size() * detail::bitmap_word_bits == values_.size())
+                bitmap_.push_back(0u);
+        }
+
+        void finish_push_back(bool has_value) noexcept
+        {
+            auto i = size() - 1u;
+            bitmap_[i / detail::bitmap_word_bits] |=
+                detail::bitmap_word(has_value) << (i % detail::bitmap_word_bits);
+        }
+
+        // select instead of branch and copy of value as it could alias, so it can be vectorized
+        static void fill_word(std::true_type, T* values, std::size_t count,
+                              detail::bitmap_word word, const T& value) noexcept
+        {
+            auto fill = value;
+            for (std::size_t i = 0u; i != count; ++i)
+                values[i] = (word >> i) & 1u ? values[i] : fill;
+        }
+
+        static void fill_word(std::false_type, T* values, std::size_t count,
+                              detail::bitmap_word word, const T& value)
+        {
+            for (std::size_t i = 0u; i != count; ++i)
+                if (!((word >> i) & 1u))
+                    values[i] = value;
+        }
+
+        std::vector<T>                   values_;
+        std::vector<detail::bitmap_word> bitmap_;
+
+        template <typename>
+        friend class optional_vector;
+        friend detail::optional_vector_access;
+    };
+
+    /// \exclude
+    namespace detail
+    {
+        struct optional_vector_access
+        {
+            template <typename T>
+            static const bitmap_word* bitmap(const optional_vector<T>& vector) noexcept
+            {
+                return vector.bitmap_.data();
+            }
+
+            template <typename T>
+            static bitmap_word* bitmap(optional_vector<T>& vector) noexcept
+            {
+                return vector.bitmap_.data();
+            }
+        };
+
+        inline bool same_size(std::size_t) noexcept
+        {
+            return true;
+        }
+
+        template <typename T, typename... Ts>
+        bool same_size(std::size_t size, const optional_vector<T>& column,
+                       const optional_vector<Ts>&... rest) noexcept
+        {
+            return column.size() == size && same_size(size, rest...);
+        }
+
+        // elements of word `w` that have a value in all columns
+        inline bitmap_word combined_word(std::size_t) noexcept
+        {
+            return ~bitmap_word(0u);
+        }
+
+        template <typename T, typename... Ts>
+        bitmap_word combined_word(std::size_t w, const optional_vector<T>& column,
+                                  const optional_vector<Ts>&... rest) noexcept
+        {
+            return optional_vector_access::bitmap(column)[w] & combined_word(w, rest...);
+        }
+
+        template <typename Func, typename R, typename... Ts>
+        void apply_word(Func& f, R* out, std::size_t count, bitmap_word word, const Ts*... in)
+        {
+            if (word == bitmap_mask(count))
+            {
+                for (std::size_t i = 0u; i != count; ++i)
+                    out[i] = f(in[i]...);
+            }
+            else if (word != 0u)
+            {
+                for (std::size_t i = 0u; i != count; ++i)
+                    if ((word >> i) & 1u)
+                        out[i] = f(in[i]...);
+            }
+        }
+
+        template <typename Visitor, typename... Args>
+        auto call_visitor(int, Visitor& visitor, Args&&... args)
+            -> decltype((void)visitor(std::forward<Args>(args)...))
+        {
+            visitor(std::forward<Args>(args)...);
+        }
+
+        template <typename Visitor, typename... Args>
+        void call_visitor(short, Visitor&, Args&&...)
+        {
+            static_assert(visitor_allow_incomplete<Visitor>::value,
+                          "call to visitor does not cover all possible combinations");
+        }
+
+        // calls the visitor with the value of each column or nullopt, selected by its bitmap word,
+        // each step moves the argument of the current column to the end, like visit_optional
+        template <typename... Ts>
+        struct visit_element;
+
+        template <>
+        struct visit_element<>
+        {
+            template <typename Visitor, typename... Args>
+            static void call(Visitor& visitor, std::size_t, const bitmap_word*, Args&&... args)
+            {
+                call_visitor(0, visitor, std::forward<Args>(args)...);
+            }
+        };
+
+        template <typename T, typename... Ts>
+        struct visit_element<T, Ts...>
+        {
+            template <typename Visitor, typename... Args>
+            static void call(Visitor& visitor, std::size_t i, const bitmap_word* words,
+                             const T& value, const Ts&... rest, Args&&... args)
+            {
+                if ((*words >> i) & 1u)
+                    visit_element<Ts...>::call(visitor, i, words + 1, rest...,
+                                               std::forward<Args>(args)..., value);
+                else
+                    visit_element<Ts...>::call(visitor, i, words + 1, rest...,
+                                               std::forward<Args>(args)..., nullopt);
+            }
+        };
+
+        template <typename Visitor, typename... Ts>
+        void visit_word(Visitor& visitor, std::size_t w, std::size_t count, bitmap_word word,
+                        const optional_vector<Ts>&... columns)
+        {
+            auto first = w * bitmap_word_bits;
+            if (word == bitmap_mask(count))
+            {
+                // all values are present, pass them directly
+                for (std::size_t i = first; i != first + count; ++i)
+                    call_visitor(0, visitor, columns.values()[i]...);
+            }
+            else
+            {
+                // select the value or nullopt of each column by its own word
+                const bitmap_word words[] = {optional_vector_access::bitmap(columns)[w]...};
+                for (std::size_t i = 0u; i != count; ++i)
+                    visit_element<Ts...>::call(visitor, i, words, columns.values()[first + i]...);
+            }
+        }
+    } // namespace detail
+
+    /// \returns An [type_safe::optional_vector<T>]() of the same size as the `columns`,
+    /// whose `i`th element has the value `f(values...)` if the `i`th elements of all `columns` have a value,
+    /// or no value otherwise.
+    /// This is the element-wise version of [type_safe::apply()](),
+    /// e.g. `apply(std::plus<int>{}, a, b)` adds two columns of optional integers.
+    /// \requires All `columns` must have the same size,
+    /// `f` must be callable with the `const` values and return a default constructible type.
+    /// \notes The presence of all columns is combined 64 elements at a time,
+    /// `f` is only called for elements where all columns have a value,
+    /// and groups of 64 elements that all have a value are computed without checking,
+    /// by a loop that can be vectorized.
+    template <typename Func, typename T, typename... Ts>
+    auto apply(Func&& f, const optional_vector<T>& column, const optional_vector<Ts>&... columns)
+        -> optional_vector<typename std::decay<decltype(
+            f(std::declval<const T&>(), std::declval<const Ts&>()...))>::type>
+    {
+        using result_type = typename std::decay<decltype(
+            f(std::declval<const T&>(), std::declval<const Ts&>()...))>::type;
+        DEBUG_ASSERT(detail::same_size(column.size(), columns...), detail::assert_handler{},
+                     "size mismatch");
+
+        optional_vector<result_type> result(column.size());
+        for (std::size_t w = 0u; w != detail::bitmap_word_count(column.size()); ++w)
+        {
+            auto first = w * detail::bitmap_word_bits;
+            auto count = column.size() - first < detail::bitmap_word_bits ?
+                             column.size() - first :
+                             detail::bitmap_word_bits;
+            auto word = detail::combined_word(w, column, columns...);
+
+            detail::apply_word(f, result.values().data() + first, count, word,
+                               column.values().data() + first,
+                               columns.values().data() + first...);
+            detail::optional_vector_access::bitmap(result)[w] = word;
+        }
+        return result;
+    }
+
+    /// \effects Calls [type_safe::visit()]() with the `i`th elements of all `columns`, for each `i` in order,
+    /// i.e. `visitor` is called with the `const` value of each element or `nullopt`, if it has none.
+    /// \requires All `columns` must have the same size.
+    /// \notes The presence of all columns is combined 64 elements at a time.
+    /// For groups of 64 elements that all have a value `visitor` is called with the values directly,
+    /// without any per-element check.
+    /// Otherwise the value or `nullopt` of each column is selected by the bits of its bitmap word,
+    /// no optionals are created.
+    template <typename Visitor, typename T, typename... Ts>
+    void visit(Visitor&& visitor, const optional_vector<T>& column,
+               const optional_vector<Ts>&... columns)
+    {
+        DEBUG_ASSERT(detail::same_size(column.size(), columns...), detail::assert_handler{},
+                     "size mismatch");
+
+        for (std::size_t w = 0u; w != detail::bitmap_word_count(column.size()); ++w)
+        {
+            auto first = w * detail::bitmap_word_bits;
+            auto count = column.size() - first < detail::bitmap_word_bits ?
+                             column.size() - first :
+                             detail::bitmap_word_bits;
+            detail::visit_word(visitor, w, count, detail::combined_word(w, column, columns...),
+                               column, columns...);
+        }
+    }
+} // namespace type_safe
+
+#endif // TYPE_SAFE_OPTIONAL_VECTOR_HPP_INCLUDED
@@ -5,6 +5,8 @@
 #ifndef TYPE_SAFE_STRONG_TYPEDEF_HPP_INCLUDED
 #define TYPE_SAFE_STRONG_TYPEDEF_HPP_INCLUDED
 
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
 #include <iterator>
 #include <type_traits>
@@ -87,6 +89,23 @@ namespace type_safe
     template <class StrongTypedef>
     using underlying_type = decltype(detail::underlying_type(std::declval<StrongTypedef>()));
 
+    /// \exclude
+    namespace detail
+    {
+        // the underlying value of a strong typedef, any other value as-is
+        template <class StrongTypedef, typename T>
+        using transparent_type =
+            typename std::conditional<std::is_base_of<StrongTypedef, T>::value,
+                                      const type_safe::underlying_type<StrongTypedef>&,
+                                      const T&>::type;
+
+        template <class StrongTypedef, typename T>
+        transparent_type<StrongTypedef, T> transparent_value(const T& val) noexcept
+        {
+            return static_cast<transparent_type<StrongTypedef, T>>(val);
+        }
+    } // namespace detail
+
     namespace strong_typedef_op
     {
         template <class StrongTypedef, typename Result = bool_t>
@@ -407,7 +426,102 @@ namespace type_safe
                 return out << static_cast<const type&>(val);
             }
         };
+
+        /// A transparent comparator that compares strong typedefs by their underlying values.
+        ///
+        /// The arguments can be the strong typedef itself or any type comparable with the underlying type,
+        /// so associative containers using it can look up keys without creating a strong typedef:
+        /// ```cpp
+        /// std::map<my_id, int, type_safe::strong_typedef_op::transparent_less<my_id>> map;
+        /// map.find("id"); // no temporary my_id or std::string
+        /// ```
+        /// \notes Heterogeneous lookup in [std::map]() requires C++14.
+        template <class StrongTypedef>
+        struct transparent_less
+        {
+            using is_transparent = void;
+
+            template <typename T, typename U>
+            bool operator()(const T& lhs, const U& rhs) const
+            {
+                return static_cast<bool>(detail::transparent_value<StrongTypedef>(lhs)
+                                         < detail::transparent_value<StrongTypedef>(rhs));
+            }
+        };
+
+        /// A transparent equality predicate that compares strong typedefs by their underlying values.
+        ///
+        /// Like [type_safe::strong_typedef_op::transparent_less<StrongTypedef>](),
+        /// the arguments can be the strong typedef itself or any type comparable with the underlying type.
+        template <class StrongTypedef>
+        struct transparent_equal
+        {
+            using is_transparent = void;
+
+            template <typename T, typename U>
+            bool operator()(const T& lhs, const U& rhs) const
+            {
+                return static_cast<bool>(detail::transparent_value<StrongTypedef>(lhs)
+                                         == detail::transparent_value<StrongTypedef>(rhs));
+            }
+        };
+
+        /// A transparent hash that hashes strong typedefs like their underlying values using `Hash`.
+        ///
+        /// The argument can be the strong typedef itself or any other type `Hash` accepts,
+        /// so together with [type_safe::strong_typedef_op::transparent_equal<StrongTypedef>]()
+        /// unordered containers can look up keys without creating a strong typedef:
+        /// ```cpp
+        /// using hash = type_safe::strong_typedef_op::transparent_hash<my_id, std::hash<std::string_view>>;
+        /// std::unordered_map<my_id, int, hash, type_safe::strong_typedef_op::transparent_equal<my_id>> map;
+        /// map.find(std::string_view("id")); // no temporary my_id or std::string
+        /// ```
+        /// \requires `Hash` must return the same hash for the underlying value
+        /// and for all lookup values that compare equal to it,
+        /// e.g. [std::hash<std::string_view>]() for a [std::string]().
+        /// \notes Heterogeneous lookup in [std::unordered_map]() requires C++20.
+        template <class StrongTypedef, class Hash = std::hash<underlying_type<StrongTypedef>>>
+        struct transparent_hash
+        {
+            using is_transparent = void;
+
+            template <typename T>
+            std::size_t operator()(const T& val) const
+            {
+                return Hash{}(detail::transparent_value<StrongTypedef>(val));
+            }
+        };
     } // namespace strong_typedef_op
+
+    /// Hashes a strong typedef like its underlying type.
+    ///
+    /// It is not one of the `strong_typedef_op` base classes of the strong typedef,
+    /// as those cannot enable [std::hash]() for it,
+    /// use it as the base class of the specialization instead:
+    /// ```cpp
+    /// namespace std
+    /// {
+    ///     template <>
+    ///     struct hash<my_handle> : type_safe::hashable<my_handle>
+    ///     {
+    ///     };
+    /// }
+    /// ```
+    /// \notes Use [type_safe::hash_cached<T, Hash>]() as underlying type to compute the hash only once.
+    template <class StrongTypedef>
+    struct hashable
+    {
+        using argument_type = StrongTypedef;
+        using result_type   = std::size_t;
+
+        std::size_t operator()(const StrongTypedef& val) const
+            noexcept(noexcept(std::hash<underlying_type<StrongTypedef>>{}(
+                std::declval<const underlying_type<StrongTypedef>&>())))
+        {
+            using type = underlying_type<StrongTypedef>;
+            return std::hash<type>{}(static_cast<const type&>(val));
+        }
+    };
 } // namespace type_safe
 
 #endif // TYPE_SAFE_STRONG_TYPEDEF_HPP_INCLUDED
@@ -76,3 +76,284 @@ TEST_CASE("over/underflow")
         REQUIRE(!detail::will_modulo_error(detail::signed_integer_tag{}, 1, 1));
     }
 }
+
+// the checks must be usable at compile-time, whatever tag the policies use
+static_assert(detail::will_addition_error(detail::arithmetic_tag_for<int>{},
+                                          std::numeric_limits<int>::max(), 1),
+              "");
+static_assert(!detail::will_subtraction_error(detail::arithmetic_tag_for<int>{}, 0, 1), "");
+static_assert(detail::will_multiplication_error(detail::arithmetic_tag_for<unsigned>{},
+                                                std::numeric_limits<unsigned>::max(), 2u),
+              "");
+
+#if TYPE_SAFE_DETAIL_HAS_BUILTIN_INTEGER_TAG
+namespace
+{
+    template <typename T>
+    void check_builtin()
+    {
+        using limits = std::numeric_limits<T>;
+        for (auto a = int(limits::min()); a <= int(limits::max()); ++a)
+            for (auto b = int(limits::min()); b <= int(limits::max()); ++b)
+            {
+                auto x = T(a);
+                auto y = T(b);
+                auto tag = detail::integer_tag_for<T>{};
+                auto builtin = detail::builtin_integer_tag{};
+
+                REQUIRE(detail::will_addition_error(builtin, x, y)
+                        == detail::will_addition_error(tag, x, y));
+                REQUIRE(detail::will_subtraction_error(builtin, x, y)
+                        == detail::will_subtraction_error(tag, x, y));
+                REQUIRE(detail::will_multiplication_error(builtin, x, y)
+                        == detail::will_multiplication_error(tag, x, y));
+                REQUIRE(detail::will_division_error(builtin, x, y)
+                        == detail::will_division_error(tag, x, y));
+                REQUIRE(detail::will_modulo_error(builtin, x, y)
+                        == detail::will_modulo_error(tag, x, y));
+            }
+    }
+} // namespace
+
+TEST_CASE("over/underflow builtin")
+{
+    SECTION("unsigned")
+    {
+        check_builtin<unsigned char>();
+
+        auto max = std::numeric_limits<unsigned long long>::max();
+        REQUIRE(detail::will_addition_error(detail::builtin_integer_tag{}, max, 1ull));
+        REQUIRE(!detail::will_addition_error(detail::builtin_integer_tag{}, max - 1ull, 1ull));
+        REQUIRE(detail::will_subtraction_error(detail::builtin_integer_tag{}, 0ull, 1ull));
+        REQUIRE(detail::will_multiplication_error(detail::builtin_integer_tag{}, max / 2ull, 3ull));
+        REQUIRE(!detail::will_multiplication_error(detail::builtin_integer_tag{}, max / 3ull, 3ull));
+    }
+    SECTION("signed")
+    {
+        check_builtin<signed char>();
+
+        auto max = std::numeric_limits<long long>::max();
+        auto min = std::numeric_limits<long long>::min();
+        REQUIRE(detail::will_addition_error(detail::builtin_integer_tag{}, max, 1ll));
+        REQUIRE(detail::will_addition_error(detail::builtin_integer_tag{}, min, -1ll));
+        REQUIRE(detail::will_subtraction_error(detail::builtin_integer_tag{}, min, 1ll));
+        REQUIRE(detail::will_multiplication_error(detail::builtin_integer_tag{}, max / 2ll, -3ll));
+        REQUIRE(!detail::will_multiplication_error(detail::builtin_integer_tag{}, max / 3ll, -3ll));
+        REQUIRE(detail::will_multiplication_error(detail::builtin_integer_tag{}, min, -1ll));
+        REQUIRE(detail::will_division_error(detail::builtin_integer_tag{}, min, -1ll));
+    }
+}
+#endif
+
+namespace
+{
+    template <typename T>
+    T saturate(long long value)
+    {
+        return value > std::numeric_limits<T>::max() ?
+                   std::numeric_limits<T>::max() :
+                   (value < std::numeric_limits<T>::min() ? std::numeric_limits<T>::min() : T(value));
+    }
+
+    template <typename T>
+    void check_saturating()
+    {
+        using limits = std::numeric_limits<T>;
+        for (auto a = int(limits::min()); a <= int(limits::max()); ++a)
+            for (auto b = int(limits::min()); b <= int(limits::max()); ++b)
+            {
+                auto x = T(a);
+                auto y = T(b);
+
+                REQUIRE(saturating_arithmetic::do_addition(x, y) == saturate<T>(a + b));
+                REQUIRE(saturating_arithmetic::do_subtraction(x, y) == saturate<T>(a - b));
+                REQUIRE(saturating_arithmetic::do_multiplication(x, y) == saturate<T>(a * b));
+                if (b != 0)
+                {
+                    REQUIRE(saturating_arithmetic::do_division(x, y) == saturate<T>(a / b));
+                    REQUIRE(saturating_arithmetic::do_modulo(x, y) == T(a % b));
+                }
+            }
+    }
+} // namespace
+
+static_assert(saturating_arithmetic::do_addition(std::numeric_limits<int>::max(), 1)
+                  == std::numeric_limits<int>::max(),
+              "");
+static_assert(saturating_arithmetic::do_subtraction(0u, 1u) == 0u, "");
+
+TEST_CASE("saturating_arithmetic")
+{
+    SECTION("unsigned")
+    {
+        check_saturating<unsigned char>();
+
+        auto max = std::numeric_limits<unsigned long long>::max();
+        REQUIRE(saturating_arithmetic::do_addition(max - 1ull, 5ull) == max);
+        REQUIRE(saturating_arithmetic::do_addition(max - 5ull, 1ull) == max - 4ull);
+        REQUIRE(saturating_arithmetic::do_subtraction(1ull, max) == 0ull);
+        REQUIRE(saturating_arithmetic::do_multiplication(max / 2ull, 3ull) == max);
+        REQUIRE(saturating_arithmetic::do_multiplication(max / 3ull, 3ull) == max / 3ull * 3ull);
+    }
+    SECTION("signed")
+    {
+        check_saturating<signed char>();
+
+        auto max = std::numeric_limits<long long>::max();
+        auto min = std::numeric_limits<long long>::min();
+        REQUIRE(saturating_arithmetic::do_addition(max, 1ll) == max);
+        REQUIRE(saturating_arithmetic::do_addition(min, -1ll) == min);
+        REQUIRE(saturating_arithmetic::do_subtraction(min, 1ll) == min);
+        REQUIRE(saturating_arithmetic::do_subtraction(max, -1ll) == max);
+        REQUIRE(saturating_arithmetic::do_multiplication(max / 2ll, 3ll) == max);
+        REQUIRE(saturating_arithmetic::do_multiplication(max / 2ll, -3ll) == min);
+        REQUIRE(saturating_arithmetic::do_multiplication(min, -1ll) == max);
+        REQUIRE(saturating_arithmetic::do_multiplication(-5ll, -7ll) == 35ll);
+        REQUIRE(saturating_arithmetic::do_division(min, -1ll) == max);
+        REQUIRE(saturating_arithmetic::do_modulo(min, -1ll) == 0ll);
+    }
+}
+
+namespace
+{
+    template <typename T>
+    void check_wrapping()
+    {
+        using limits = std::numeric_limits<T>;
+        using unsigned_t = typename std::make_unsigned<T>::type;
+        for (auto a = int(limits::min()); a <= int(limits::max()); ++a)
+            for (auto b = int(limits::min()); b <= int(limits::max()); ++b)
+            {
+                auto x = T(a);
+                auto y = T(b);
+
+                REQUIRE(wrapping_arithmetic::do_addition(x, y) == T(unsigned_t(a + b)));
+                REQUIRE(wrapping_arithmetic::do_subtraction(x, y) == T(unsigned_t(a - b)));
+                REQUIRE(wrapping_arithmetic::do_multiplication(x, y) == T(unsigned_t(a * b)));
+                if (b != 0)
+                {
+                    REQUIRE(wrapping_arithmetic::do_division(x, y) == T(unsigned_t(a / b)));
+                    REQUIRE(wrapping_arithmetic::do_modulo(x, y) == T(a % b));
+                }
+            }
+    }
+} // namespace
+
+static_assert(wrapping_arithmetic::do_addition(std::numeric_limits<unsigned>::max(), 1u) == 0u,
+              "");
+static_assert(wrapping_arithmetic::do_subtraction(std::numeric_limits<int>::min(), 1)
+                  == std::numeric_limits<int>::max(),
+              "");
+
+TEST_CASE("wrapping_arithmetic")
+{
+    SECTION("unsigned")
+    {
+        check_wrapping<unsigned char>();
+
+        auto max = std::numeric_limits<unsigned long long>::max();
+        REQUIRE(wrapping_arithmetic::do_addition(max, 2ull) == 1ull);
+        REQUIRE(wrapping_arithmetic::do_subtraction(1ull, 2ull) == max);
+        REQUIRE(wrapping_arithmetic::do_multiplication(max, max) == 1ull);
+    }
+    SECTION("signed")
+    {
+        check_wrapping<signed char>();
+
+        auto max = std::numeric_limits<long long>::max();
+        auto min = std::numeric_limits<long long>::min();
+        REQUIRE(wrapping_arithmetic::do_addition(max, 1ll) == min);
+        REQUIRE(wrapping_arithmetic::do_subtraction(min, 1ll) == max);
+        REQUIRE(wrapping_arithmetic::do_multiplication(max, 2ll) == -2ll);
+        REQUIRE(wrapping_arithmetic::do_multiplication(min, -1ll) == min);
+        REQUIRE(wrapping_arithmetic::do_division(min, -1ll) == min);
+        REQUIRE(wrapping_arithmetic::do_modulo(min, -1ll) == 0ll);
+    }
+}
+
+TEST_CASE("sticky_arithmetic")
+{
+    auto max = std::numeric_limits<int>::max();
+    auto min = std::numeric_limits<int>::min();
+
+    SECTION("no overflow")
+    {
+        overflow_scope scope;
+        REQUIRE(sticky_arithmetic::do_addition(1, 2) == 3);
+        REQUIRE(sticky_arithmetic::do_subtraction(1, 2) == -1);
+        REQUIRE(sticky_arithmetic::do_multiplication(-3, 2) == -6);
+        REQUIRE(sticky_arithmetic::do_division(7, 2) == 3);
+        REQUIRE(sticky_arithmetic::do_modulo(7, 2) == 1);
+        REQUIRE(!scope.overflowed());
+        REQUIRE_NOTHROW(scope.check());
+    }
+    SECTION("overflow")
+    {
+        overflow_scope scope;
+        REQUIRE(sticky_arithmetic::do_addition(max, 1) == min);
+        REQUIRE(scope.overflowed());
+        REQUIRE(sticky_arithmetic::do_addition(1, 2) == 3);
+        REQUIRE(scope.overflowed());
+        REQUIRE_THROWS_AS(scope.check(), checked_arithmetic::error);
+    }
+    SECTION("operations")
+    {
+        {
+            overflow_scope scope;
+            sticky_arithmetic::do_subtraction(0u, 1u);
+            REQUIRE(scope.overflowed());
+        }
+        {
+            overflow_scope scope;
+            sticky_arithmetic::do_multiplication(max, 2);
+            REQUIRE(scope.overflowed());
+        }
+        {
+            overflow_scope scope;
+            sticky_arithmetic::do_multiplication(std::numeric_limits<long long>::max(), 2ll);
+            REQUIRE(scope.overflowed());
+        }
+        {
+            overflow_scope scope;
+            REQUIRE(sticky_arithmetic::do_division(5, 0) == 5);
+            REQUIRE(scope.overflowed());
+        }
+        {
+            overflow_scope scope;
+            REQUIRE(sticky_arithmetic::do_division(min, -1) == min);
+            REQUIRE(scope.overflowed());
+        }
+        {
+            overflow_scope scope;
+            REQUIRE(sticky_arithmetic::do_modulo(5, 0) == 5);
+            REQUIRE(scope.overflowed());
+        }
+    }
+    SECTION("nested")
+    {
+        overflow_scope outer;
+        {
+            overflow_scope inner;
+            REQUIRE(!inner.overflowed());
+        }
+        REQUIRE(!outer.overflowed());
+
+        sticky_arithmetic::do_addition(max, 1);
+        {
+            overflow_scope inner;
+            REQUIRE(!inner.overflowed());
+            sticky_arithmetic::do_addition(min, -1);
+            REQUIRE(inner.overflowed());
+        }
+        REQUIRE(outer.overflowed());
+    }
+    SECTION("nested inner overflow")
+    {
+        overflow_scope outer;
+        {
+            overflow_scope inner;
+            sticky_arithmetic::do_addition(max, 1);
+        }
+        REQUIRE(outer.overflowed());
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/array_ref.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+static_assert(std::is_convertible<array_ref<int>, array_ref<const int>>::value, "");
+static_assert(!std::is_convertible<array_ref<const int>, array_ref<int>>::value, "");
+static_assert(std::is_constructible<array_ref<const int>, const std::vector<int>&>::value, "");
+static_assert(!std::is_constructible<array_ref<int>, const std::vector<int>&>::value, "");
+
+TEST_CASE("array_ref")
+{
+    int array[] = {1, 2, 3, 4};
+
+    SECTION("pointer + size")
+    {
+        array_ref<int> ref(array, 4u);
+        REQUIRE(ref.data() == array);
+        REQUIRE(ref.size() == 4u);
+        REQUIRE(!ref.empty());
+        REQUIRE(ref.begin() == array);
+        REQUIRE(ref.end() == array + 4);
+
+        array_ref<int> empty(nullptr, std::size_t(0u));
+        REQUIRE(empty.empty());
+    }
+    SECTION("range")
+    {
+        array_ref<int> ref(array + 1, array + 3);
+        REQUIRE(ref.data() == array + 1);
+        REQUIRE(ref.size() == 2u);
+        REQUIRE(ref[0] == 2);
+        REQUIRE(ref[1] == 3);
+    }
+    SECTION("array")
+    {
+        array_ref<int> ref(array);
+        REQUIRE(ref.data() == array);
+        REQUIRE(ref.size() == 4u);
+
+        ref[2] = 5;
+        REQUIRE(array[2] == 5);
+    }
+    SECTION("container")
+    {
+        std::vector<int> vec(array, array + 4);
+
+        array_ref<int> ref(vec);
+        REQUIRE(ref.data() == vec.data());
+        REQUIRE(ref.size() == vec.size());
+
+        const auto&          cvec = vec;
+        array_ref<const int> cref(cvec);
+        REQUIRE(cref.data() == vec.data());
+        REQUIRE(cref.size() == vec.size());
+
+        auto made = make_array_ref(vec);
+        static_assert(std::is_same<decltype(made), array_ref<int>>::value, "");
+        REQUIRE(made.data() == vec.data());
+
+        auto cmade = make_array_ref(cvec);
+        static_assert(std::is_same<decltype(cmade), array_ref<const int>>::value, "");
+        REQUIRE(cmade.size() == vec.size());
+    }
+    SECTION("const conversion")
+    {
+        array_ref<int>       ref(array);
+        array_ref<const int> cref(ref);
+        REQUIRE(cref.data() == array);
+        REQUIRE(cref.size() == 4u);
+    }
+    SECTION("subrange")
+    {
+        array_ref<int> ref(array);
+        auto           sub = ref.subrange(1u, 2u);
+        REQUIRE(sub.data() == array + 1);
+        REQUIRE(sub.size() == 2u);
+
+        auto sum = 0;
+        for (auto i : sub)
+            sum += i;
+        REQUIRE(sum == 5);
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/atomic_optional.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace type_safe;
+
+TEST_CASE("atomic_optional")
+{
+    SECTION("constructor")
+    {
+        atomic_optional<std::uint32_t> a;
+        REQUIRE_FALSE(a.load().has_value());
+
+        atomic_optional<std::uint32_t> b(nullopt);
+        REQUIRE_FALSE(b.load().has_value());
+
+        atomic_optional<std::uint32_t> c(0u);
+        REQUIRE(c.load().has_value());
+        REQUIRE(c.load().value() == 0u);
+    }
+    SECTION("store/exchange/reset")
+    {
+        atomic_optional<std::int16_t> a;
+        a.store(std::int16_t(-1));
+        REQUIRE(a.load().value() == -1);
+
+        auto old = a.exchange(std::int16_t(4));
+        REQUIRE(old.value() == -1);
+        REQUIRE(a.load().value() == 4);
+
+        old = a.reset();
+        REQUIRE(old.value() == 4);
+        REQUIRE_FALSE(a.load().has_value());
+
+        old = a.exchange(nullopt);
+        REQUIRE_FALSE(old.has_value());
+        REQUIRE_FALSE(a.load().has_value());
+    }
+    SECTION("compare_exchange")
+    {
+        atomic_optional<char> a;
+
+        optional<char> expected('a');
+        REQUIRE_FALSE(a.compare_exchange_strong(expected, 'b'));
+        REQUIRE_FALSE(expected.has_value());
+        REQUIRE_FALSE(a.load().has_value());
+
+        REQUIRE(a.compare_exchange_strong(expected, 'b'));
+        REQUIRE(a.load().value() == 'b');
+
+        expected = 'c';
+        REQUIRE_FALSE(a.compare_exchange_strong(expected, nullopt));
+        REQUIRE(expected.value() == 'b');
+
+        while (!a.compare_exchange_weak(expected, nullopt))
+            REQUIRE(expected.value() == 'b');
+        REQUIRE_FALSE(a.load().has_value());
+    }
+    SECTION("threads")
+    {
+        atomic_optional<std::uint32_t> a;
+
+        std::vector<std::thread> threads;
+        for (auto t = 0; t != 4; ++t)
+            threads.emplace_back([&] {
+                for (auto i = 0; i != 1000; ++i)
+                {
+                    auto expected = a.load();
+                    while (!a.compare_exchange_weak(expected, expected.value_or(0u) + 1u))
+                    {
+                    }
+                }
+            });
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(a.load().value() == 4000u);
+    }
+}
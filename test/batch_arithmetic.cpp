@@ -0,0 +1,119 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/batch_arithmetic.hpp>
+
+#include <catch.hpp>
+
+#include <vector>
+
+using namespace type_safe;
+
+namespace
+{
+    struct counting_policy : default_arithmetic
+    {
+        static int errors;
+
+        static void do_batch_error(const char*) noexcept
+        {
+            ++errors;
+        }
+    };
+
+    int counting_policy::errors = 0;
+} // namespace
+
+TEST_CASE("batch_arithmetic")
+{
+    SECTION("default_arithmetic")
+    {
+        using int_t = integer<int, default_arithmetic>;
+
+        std::vector<int_t> a{1, 2, 3, -4};
+        std::vector<int_t> b{5, -6, 7, 8};
+        std::vector<int_t> out(a.size(), 0);
+
+        add(make_array_ref(out), a, b);
+        REQUIRE(out == (std::vector<int_t>{6, -4, 10, 4}));
+
+        subtract(make_array_ref(out), a, b);
+        REQUIRE(out == (std::vector<int_t>{-4, 8, -4, -12}));
+
+        multiply(make_array_ref(out), a, b);
+        REQUIRE(out == (std::vector<int_t>{5, -12, 21, -32}));
+
+        // in-place
+        add(make_array_ref(a), a, b);
+        REQUIRE(a == (std::vector<int_t>{6, -4, 10, 4}));
+    }
+    SECTION("checked_arithmetic")
+    {
+        using int_t  = integer<int, checked_arithmetic>;
+        using uint_t = integer<unsigned long long, checked_arithmetic>;
+
+        auto max = std::numeric_limits<int>::max();
+        auto min = std::numeric_limits<int>::min();
+
+        std::vector<int_t> a{1, max - 10, max / 2 + 1, min + 10};
+        std::vector<int_t> b{2, 20, 2, -20};
+        std::vector<int_t> out(a.size(), 0);
+
+        REQUIRE_THROWS_AS(add(make_array_ref(out), a, b), checked_arithmetic::error);
+        std::vector<int_t> c{0, 0, 0, 20};
+        REQUIRE_THROWS_AS(subtract(make_array_ref(out), a, c), checked_arithmetic::error);
+        REQUIRE_THROWS_AS(multiply(make_array_ref(out), a, b), checked_arithmetic::error);
+
+        a[1] = 10;
+        a[2] = max / 2;
+        a[3] = -10;
+        REQUIRE_NOTHROW(add(make_array_ref(out), a, b));
+        REQUIRE(out == (std::vector<int_t>{3, 30, max / 2 + 2, -30}));
+        REQUIRE_NOTHROW(multiply(make_array_ref(out), a, b));
+        REQUIRE(out == (std::vector<int_t>{2, 200, max - 1, 200}));
+
+        auto ull_max = std::numeric_limits<unsigned long long>::max();
+        std::vector<uint_t> ua{1u, ull_max / 2u + 1u};
+        std::vector<uint_t> ub{2u, 2u};
+        std::vector<uint_t> uout(ua.size(), 0u);
+        REQUIRE_THROWS_AS(multiply(make_array_ref(uout), ua, ub), checked_arithmetic::error);
+        REQUIRE_THROWS_AS(subtract(make_array_ref(uout), ua, ub), checked_arithmetic::error);
+        REQUIRE_NOTHROW(add(make_array_ref(uout), ua, ub));
+    }
+    SECTION("single error per batch")
+    {
+        using int_t = integer<int, counting_policy>;
+
+        auto               max = std::numeric_limits<int>::max();
+        std::vector<int_t> a{max, max, 0, max};
+        std::vector<int_t> b{1, 2, 3, 4};
+        std::vector<int_t> out(a.size(), 0);
+
+        counting_policy::errors = 0;
+        add(make_array_ref(out), a, b);
+        REQUIRE(counting_policy::errors == 1);
+        REQUIRE(static_cast<int>(out[2]) == 3);
+
+        counting_policy::errors = 0;
+        subtract(make_array_ref(out), a, b);
+        REQUIRE(counting_policy::errors == 0);
+        REQUIRE(static_cast<int>(out[0]) == max - 1);
+    }
+    SECTION("sticky_arithmetic")
+    {
+        using int_t = integer<int, sticky_arithmetic>;
+
+        auto               max = std::numeric_limits<int>::max();
+        std::vector<int_t> a{1, max, 3};
+        std::vector<int_t> b{1, 1, 1};
+        std::vector<int_t> out(a.size(), 0);
+
+        overflow_scope scope;
+        subtract(make_array_ref(out), a, b);
+        REQUIRE(!scope.overflowed());
+        add(make_array_ref(out), a, b);
+        REQUIRE(scope.overflowed());
+        REQUIRE(static_cast<int>(out[2]) == 4);
+    }
+}
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <vector>
+
 using namespace type_safe;
 
 TEST_CASE("constraints::less")
@@ -122,6 +124,144 @@ TEST_CASE("constraints::bounded")
     }
 }
 
+TEST_CASE("constraints::static_bounded")
+{
+    constraints::static_bounded<int, 0, 42> p;
+    static_assert(decltype(p)::get_lower_bound() == 0, "");
+    static_assert(decltype(p)::get_upper_bound() == 42, "");
+    static_assert(std::is_empty<decltype(p)>::value, "");
+
+    REQUIRE(p(30));
+    REQUIRE(p(0));
+    REQUIRE(p(42));
+
+    REQUIRE(!p(-5));
+    REQUIRE(!p(43));
+}
+
+namespace
+{
+    template <typename A, typename B>
+    auto can_add_impl(int) -> decltype(std::declval<A>() + std::declval<B>(), std::true_type{});
+
+    template <typename A, typename B>
+    std::false_type can_add_impl(short);
+
+    template <typename A, typename B>
+    using can_add = decltype(can_add_impl<A, B>(0));
+} // namespace
+
+TEST_CASE("static_bounded_type")
+{
+    using percent = static_bounded_type<int, 0, 100>;
+    using offset  = static_bounded_type<int, -10, 10>;
+    static_assert(sizeof(percent) == sizeof(int), "");
+
+    percent a(42);
+    offset  b(-3);
+    REQUIRE(a.get_value() == 42);
+
+    SECTION("addition")
+    {
+        auto c = a + b;
+        static_assert(std::is_same<decltype(c),
+                                   static_bounded_type<std::int_least8_t, -10, 110>>::value,
+                      "");
+        REQUIRE(c.get_value() == 39);
+
+        auto d = a + a + a;
+        static_assert(std::is_same<decltype(d),
+                                   static_bounded_type<std::uint_least16_t, 0u, 300u>>::value,
+                      "");
+        REQUIRE(d.get_value() == 126u);
+    }
+    SECTION("subtraction")
+    {
+        auto c = a - b;
+        static_assert(std::is_same<decltype(c),
+                                   static_bounded_type<std::int_least8_t, -10, 110>>::value,
+                      "");
+        REQUIRE(c.get_value() == 45);
+
+        auto d = b - a;
+        static_assert(std::is_same<decltype(d),
+                                   static_bounded_type<std::int_least8_t, -110, 10>>::value,
+                      "");
+        REQUIRE(d.get_value() == -45);
+
+        // no unsigned wrap around
+        using small = static_bounded_type<unsigned, 0u, 10u>;
+        auto e      = small(2u) - small(5u);
+        static_assert(std::is_same<decltype(e),
+                                   static_bounded_type<std::int_least8_t, -10, 10>>::value,
+                      "");
+        REQUIRE(e.get_value() == -3);
+    }
+    SECTION("multiplication")
+    {
+        auto c = a * b;
+        static_assert(std::is_same<decltype(c),
+                                   static_bounded_type<std::int_least16_t, -1000, 1000>>::value,
+                      "");
+        REQUIRE(c.get_value() == -126);
+
+        auto d = b * b;
+        static_assert(std::is_same<decltype(d),
+                                   static_bounded_type<std::int_least8_t, -100, 100>>::value,
+                      "");
+        REQUIRE(d.get_value() == 9);
+
+        using byte = static_bounded_type<unsigned char, 0u, 255u>;
+        byte x(static_cast<unsigned char>(200u));
+        auto e = x * x;
+        static_assert(std::is_same<decltype(e),
+                                   static_bounded_type<std::uint_least16_t, 0u, 65025u>>::value,
+                      "");
+        REQUIRE(e.get_value() == 40000u);
+    }
+    SECTION("bounded_cast")
+    {
+        auto sum = a + a;
+
+        // contained, no check
+        auto c = bounded_cast<static_bounded_type<int, 0, 1000>>(sum);
+        REQUIRE(c.get_value() == 84);
+        auto d = bounded_cast<short>(sum);
+        static_assert(std::is_same<decltype(d), short>::value, "");
+        REQUIRE(d == 84);
+        auto e = bounded_cast<integer<std::uint8_t>>(sum);
+        REQUIRE(static_cast<std::uint8_t>(e) == 84u);
+
+        // upper bound checked
+        auto f = bounded_cast<percent>(sum);
+        REQUIRE(f.get_value() == 84);
+
+        // upper bound clamped
+        using clamped = constrained_type<int, constraints::static_bounded<int, 0, 50>,
+                                         clamping_verifier>;
+        REQUIRE(bounded_cast<clamped>(sum).get_value() == 50);
+        REQUIRE(bounded_cast<clamped>(b + b).get_value() == 0);
+    }
+    SECTION("verifier")
+    {
+        using clamped = constrained_type<int, constraints::static_bounded<int, 0, 100>,
+                                         clamping_verifier>;
+        auto c = clamped(40) * clamped(3) - clamped(1);
+        static_assert(std::is_same<decltype(c),
+                                   constrained_type<std::int_least16_t,
+                                                    constraints::static_bounded<std::int_least16_t,
+                                                                                -100, 10000>,
+                                                    clamping_verifier>>::value,
+                      "");
+        REQUIRE(c.get_value() == 119);
+
+        // different verifiers require a bounded_cast()
+        static_assert(can_add<percent, percent>::value, "");
+        static_assert(!can_add<percent, clamped>::value, "");
+        REQUIRE((a + bounded_cast<percent>(clamped(7))).get_value() == 49);
+    }
+}
+
 TEST_CASE("clamping_verifier")
 {
     SECTION("less_equal")
@@ -192,4 +332,96 @@ TEST_CASE("clamping_verifier")
         clamping_verifier::verify(f, p);
         REQUIRE(f == 0);
     }
+    SECTION("static_bounded")
+    {
+        using type = constrained_type<int, constraints::static_bounded<int, 0, 42>,
+                                      clamping_verifier>;
+        static_assert(sizeof(type) == sizeof(int), "");
+
+        REQUIRE(type(30).get_value() == 30);
+        REQUIRE(type(42).get_value() == 42);
+        REQUIRE(type(50).get_value() == 42);
+        REQUIRE(type(-20).get_value() == 0);
+    }
+}
+
+TEST_CASE("clamp")
+{
+    SECTION("closed_interval")
+    {
+        constraints::closed_interval<int> p(0, 42);
+
+        int a = 50;
+        clamp(p, a);
+        REQUIRE(a == 42);
+
+        int values[] = {30, -20, 0, 42, 50, 10};
+        clamp(p, make_array_ref(values));
+        REQUIRE(values[0] == 30);
+        REQUIRE(values[1] == 0);
+        REQUIRE(values[2] == 0);
+        REQUIRE(values[3] == 42);
+        REQUIRE(values[4] == 42);
+        REQUIRE(values[5] == 10);
+
+        clamp(p, array_ref<int>(values, std::size_t(0u)));
+
+        // containers and arrays can be passed directly
+        std::vector<int> vec = {-1, 20, 43};
+        clamp(p, vec);
+        REQUIRE(vec[0] == 0);
+        REQUIRE(vec[1] == 20);
+        REQUIRE(vec[2] == 42);
+
+        int array[] = {100, -100};
+        clamp(p, array);
+        REQUIRE(array[0] == 42);
+        REQUIRE(array[1] == 0);
+    }
+    SECTION("static_bounded")
+    {
+        constraints::static_bounded<int, -5, 5> p;
+
+        long values[] = {-10, -5, 0, 5, 10};
+        clamp(p, make_array_ref(values));
+        REQUIRE(values[0] == -5);
+        REQUIRE(values[1] == -5);
+        REQUIRE(values[2] == 0);
+        REQUIRE(values[3] == 5);
+        REQUIRE(values[4] == 5);
+
+        std::vector<int> vec = {-6, 6};
+        clamp(p, vec);
+        REQUIRE(vec[0] == -5);
+        REQUIRE(vec[1] == 5);
+    }
+}
+
+TEST_CASE("make_clamped")
+{
+    SECTION("single")
+    {
+        auto a = make_clamped(50, 0, 42);
+        REQUIRE(a.get_value() == 42);
+        REQUIRE(a.get_constraint().get_upper_bound() == 42);
+    }
+    SECTION("bulk")
+    {
+        constraints::closed_interval<int> p(0, 42);
+
+        int  values[] = {30, -20, 42, 50};
+        auto result   = make_clamped(p, values);
+        REQUIRE(result.size() == 4u);
+        REQUIRE(result[0].get_value() == 30);
+        REQUIRE(result[1].get_value() == 0);
+        REQUIRE(result[2].get_value() == 42);
+        REQUIRE(result[3].get_value() == 42);
+        for (auto& val : result)
+        {
+            REQUIRE(val.get_constraint().get_lower_bound() == 0);
+            REQUIRE(val.get_constraint().get_upper_bound() == 42);
+        }
+
+        REQUIRE(make_clamped(p, array_ref<const int>(values, std::size_t(0u))).empty());
+    }
 }
@@ -0,0 +1,123 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/compact_optional.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+    struct view
+    {
+        const char* str;
+        std::size_t size;
+
+        view() noexcept : view(nullptr, 0u)
+        {
+        }
+
+        view(const char* s, std::size_t n) noexcept : str(s), size(n)
+        {
+        }
+
+        bool empty() const noexcept
+        {
+            return size == 0u;
+        }
+    };
+} // namespace
+
+namespace type_safe
+{
+    // the non_empty niche is opt-in
+    template <>
+    struct constraint_niche<constraints::non_empty, view>
+    {
+        static view value() noexcept
+        {
+            return view();
+        }
+    };
+} // namespace type_safe
+
+TEST_CASE("compact_optional")
+{
+    SECTION("non_null")
+    {
+        using ptr = constrained_type<int*, constraints::non_null>;
+        static_assert(sizeof(compact_optional<ptr>) == sizeof(int*), "");
+        static_assert(std::is_same<optional<ptr>,
+                                   basic_optional<direct_optional_storage<ptr>>>::value,
+                      "");
+
+        compact_optional<ptr> a;
+        REQUIRE(!a.has_value());
+
+        int i = 0;
+        a.emplace(&i);
+        REQUIRE(a.has_value());
+        REQUIRE(a.value().get_value() == &i);
+
+        compact_optional<ptr> b(a);
+        REQUIRE(b.has_value());
+        REQUIRE(b.value().get_value() == &i);
+
+        a.reset();
+        REQUIRE(!a.has_value());
+        REQUIRE(b.has_value());
+
+        b = a;
+        REQUIRE(!b.has_value());
+    }
+    SECTION("non_empty")
+    {
+        using view_type = constrained_type<view, constraints::non_empty>;
+        static_assert(sizeof(compact_optional<view_type>) == sizeof(view), "");
+
+        compact_optional<view_type> a;
+        REQUIRE(!a.has_value());
+
+        a.emplace(view("hi", 2u));
+        REQUIRE(a.has_value());
+        REQUIRE(a.value().get_value().size == 2u);
+
+        struct other_view : view
+        {
+        };
+        using other_view_type = constrained_type<other_view, constraints::non_empty>;
+        static_assert(std::is_same<compact_optional<other_view_type>,
+                                   basic_optional<direct_optional_storage<other_view_type>>>::value,
+                      "");
+
+        using string = constrained_type<std::string, constraints::non_empty>;
+        static_assert(std::is_same<compact_optional<string>,
+                                   basic_optional<direct_optional_storage<string>>>::value,
+                      "");
+    }
+    SECTION("no niche")
+    {
+        using type = constrained_type<int, constraints::non_default>;
+        static_assert(std::is_same<compact_optional<type>,
+                                   basic_optional<direct_optional_storage<type>>>::value,
+                      "");
+
+        static_assert(std::is_same<compact_optional<int>, optional<int>>::value, "");
+    }
+    SECTION("tagged_type")
+    {
+        // a tagged type can store a value violating the constraint
+        using type = tagged_type<int*, constraints::non_null>;
+        static_assert(std::is_same<compact_optional<type>,
+                                   basic_optional<direct_optional_storage<type>>>::value,
+                      "");
+
+        int*                   null = nullptr;
+        compact_optional<type> a{type(null)};
+        REQUIRE(a.has_value());
+    }
+}
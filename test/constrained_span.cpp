@@ -0,0 +1,177 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/constrained_span.hpp>
+
+#include <catch.hpp>
+
+#include <type_safe/bounded_type.hpp>
+
+using namespace type_safe;
+
+namespace
+{
+    // counts the calls and checks the predicate
+    struct span_verifier
+    {
+        static int  count;
+        static bool expected;
+
+        template <typename T, typename Predicate>
+        static void verify(const T& value, const Predicate& p)
+        {
+            ++count;
+            REQUIRE(p(value) == expected);
+        }
+    };
+
+    int  span_verifier::count;
+    bool span_verifier::expected;
+
+    struct less_than
+    {
+        int bound;
+
+        bool operator()(int i) const
+        {
+            return i < bound;
+        }
+    };
+} // namespace
+
+TEST_CASE("constrained_span")
+{
+    using span = constrained_span<int, constraints::non_default, span_verifier>;
+    using constrained = constrained_type<int, constraints::non_default, span_verifier>;
+    static_assert(std::is_same<span::constrained_value_type, constrained>::value, "");
+    static_assert(sizeof(span) == sizeof(array_ref<int>), "");
+
+    span_verifier::count    = 0;
+    span_verifier::expected = true;
+
+    int values[] = {1, 2, 3, 4};
+
+    SECTION("constructor")
+    {
+        span a(values);
+        REQUIRE(span_verifier::count == 1);
+        REQUIRE(a.size() == 4u);
+        REQUIRE(!a.empty());
+        REQUIRE(a.get_values().data() == values);
+
+        values[1]               = 0;
+        span_verifier::expected = false;
+        span b(values);
+        REQUIRE(span_verifier::count == 2);
+
+        span_verifier::expected = true;
+        span c(array_ref<int>(nullptr, std::size_t(0u)));
+        REQUIRE(c.empty());
+    }
+    SECTION("access")
+    {
+        span a(values);
+        REQUIRE(a.get_value(2) == 3);
+        REQUIRE(&a.get_value(2) == &values[2]);
+
+        auto c = a[2];
+        static_assert(std::is_same<decltype(c), constrained>::value, "");
+        REQUIRE(c.get_value() == 3);
+        REQUIRE(span_verifier::count == 1);
+    }
+    SECTION("modify()")
+    {
+        span a(values);
+
+        {
+            auto modifier = a.modify(1, 2);
+            REQUIRE(modifier.get().size() == 2u);
+            modifier.get()[0] = 5;
+            modifier.get()[1] = 6;
+        }
+        REQUIRE(span_verifier::count == 2);
+        REQUIRE(values[1] == 5);
+        REQUIRE(values[2] == 6);
+
+        {
+            // only the range is verified
+            values[0] = 0;
+
+            auto modifier = a.modify(2, 2);
+            modifier.get()[1] = 7;
+        }
+        REQUIRE(span_verifier::count == 3);
+        values[0] = 1;
+
+        {
+            auto modifier = a.modify();
+            REQUIRE(modifier.get().size() == 4u);
+            modifier.get()[3] = 0;
+            span_verifier::expected = false;
+        }
+        REQUIRE(span_verifier::count == 4);
+
+        {
+            auto a_modifier = a.modify(0, 1);
+            auto b_modifier(std::move(a_modifier));
+            span_verifier::expected = true;
+        }
+        REQUIRE(span_verifier::count == 5);
+    }
+    SECTION("const")
+    {
+        const int const_values[] = {1, 2};
+
+        auto a = make_constrained_span<span_verifier>(make_array_ref(const_values),
+                                                      constraints::non_default{});
+        static_assert(std::is_same<decltype(a), constrained_span<const int,
+                                                                 constraints::non_default,
+                                                                 span_verifier>>::value,
+                      "");
+        REQUIRE(a[1].get_value() == 2);
+    }
+    SECTION("stateful")
+    {
+        auto a = make_constrained_span(make_array_ref(values), less_than{5});
+        REQUIRE(a.get_constraint().bound == 5);
+        REQUIRE(a.get_value(3) == 4);
+        REQUIRE(a[3].get_constraint().bound == 5);
+        a.modify(0, 1).get()[0] = 4;
+        REQUIRE(values[0] == 4);
+    }
+    SECTION("clamping_verifier")
+    {
+        // a verifier that changes the values is called for each value
+        using clamped_span =
+            constrained_span<int, constraints::closed_interval<int>, clamping_verifier>;
+        static_assert(!detail::is_range_verifier<clamping_verifier, int,
+                                                 constraints::closed_interval<int>>::value,
+                      "");
+        static_assert(detail::is_range_verifier<assertion_verifier, int,
+                                                constraints::closed_interval<int>>::value,
+                      "");
+
+        int          clamp_values[] = {-5, 5, 15};
+        clamped_span a(clamp_values, constraints::closed_interval<int>(0, 10));
+        REQUIRE(clamp_values[0] == 0);
+        REQUIRE(clamp_values[1] == 5);
+        REQUIRE(clamp_values[2] == 10);
+
+        a.modify(1, 1).get()[0] = 20;
+        REQUIRE(clamp_values[1] == 10);
+        REQUIRE(a[1].get_value() == 10);
+    }
+}
+
+TEST_CASE("tagged_span")
+{
+    int values[] = {0, 1};
+
+    auto a = make_tagged_span(make_array_ref(values), constraints::non_default{});
+    static_assert(std::is_same<decltype(a), tagged_span<int, constraints::non_default>>::value,
+                  "");
+    REQUIRE(a[0].get_value() == 0);
+    a.modify().get()[1] = 0;
+    REQUIRE(values[1] == 0);
+}
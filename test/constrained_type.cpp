@@ -173,3 +173,197 @@ TEST_CASE("constraints::non_invalid")
     REQUIRE(p(my_bool{true}));
     REQUIRE(!p(my_bool{false}));
 }
+
+struct my_view
+{
+    const char* str;
+    std::size_t size;
+
+    my_view() noexcept : my_view(nullptr, 0u)
+    {
+    }
+
+    my_view(const char* s, std::size_t n) noexcept : str(s), size(n)
+    {
+    }
+
+    bool empty() const noexcept
+    {
+        return size == 0u;
+    }
+};
+
+namespace
+{
+    struct empty_base
+    {
+    };
+
+    // shares an empty base with the value, which used to prevent the empty base optimization
+    struct shared_base_constraint : empty_base
+    {
+        template <typename T>
+        bool operator()(const T&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename T, typename Predicate>
+        static void verify(const T&, const Predicate&) noexcept
+        {
+        }
+    };
+
+    struct shared_base_value : empty_base
+    {
+        int value;
+    };
+
+    template <class ConstrainedType>
+    using has_value_size =
+        std::integral_constant<bool, sizeof(ConstrainedType)
+                                         == sizeof(typename ConstrainedType::value_type)>;
+} // namespace
+
+// the built-in stateless constraints
+static_assert(has_value_size<constrained_type<int*, constraints::non_null>>::value, "");
+static_assert(has_value_size<constrained_type<my_view, constraints::non_empty>>::value, "");
+static_assert(has_value_size<constrained_type<std::string, constraints::non_empty>>::value, "");
+static_assert(has_value_size<constrained_type<int, constraints::non_default>>::value, "");
+static_assert(has_value_size<constrained_type<int*, constraints::non_invalid>>::value, "");
+static_assert(has_value_size<tagged_type<int*, constraints::owner>>::value, "");
+// shared bases and nesting
+static_assert(has_value_size<constrained_type<shared_base_value, shared_base_constraint>>::value,
+              "");
+static_assert(has_value_size<constrained_type<shared_base_value, shared_base_constraint,
+                                              shared_base_constraint>>::value,
+              "");
+static_assert(has_value_size<constrained_type<constrained_type<int, constraints::non_default>,
+                                              constraints::non_default>>::value,
+              "");
+
+static_assert(is_value_layout_compatible<constrained_type<int, constraints::non_default>>::value,
+              "");
+static_assert(is_value_layout_compatible<
+                  constrained_type<shared_base_value, shared_base_constraint>>::value,
+              "");
+static_assert(!is_value_layout_compatible<int>::value, "");
+
+TEST_CASE("constrained_type layout")
+{
+    struct stateful_predicate
+    {
+        int invalid;
+
+        bool operator()(int i) const
+        {
+            return i != invalid;
+        }
+    };
+    static_assert(!is_value_layout_compatible<constrained_type<int, stateful_predicate>>::value,
+                  "");
+
+    using type = constrained_type<int, constraints::non_default>;
+    type array[] = {type(1), type(2), type(3)};
+
+    static_assert(sizeof(array) == 3 * sizeof(int), "");
+    REQUIRE(array[0].get_value() == 1);
+    REQUIRE(array[1].get_value() == 2);
+    REQUIRE(array[2].get_value() == 3);
+
+    constrained_type<int, stateful_predicate> stateful(4, stateful_predicate{5});
+    REQUIRE(stateful.get_constraint().invalid == 5);
+}
+
+struct counting_verifier
+{
+    static int count;
+
+    template <typename T, typename Predicate>
+    static void verify(const T&, const Predicate&)
+    {
+        ++count;
+    }
+};
+
+int counting_verifier::count;
+
+TEST_CASE("constrain_all")
+{
+    struct less_than
+    {
+        int bound;
+
+        bool operator()(int i) const
+        {
+            return i < bound;
+        }
+    };
+
+    SECTION("valid")
+    {
+        int values[] = {1, 2, 3};
+
+        auto batch = constrain_all(make_array_ref(values), constraints::non_default{});
+        static_assert(std::is_same<decltype(batch)::value_type,
+                                   constrained_type<int, constraints::non_default>>::value,
+                      "");
+        REQUIRE(batch);
+        REQUIRE(batch.is_valid());
+        REQUIRE(batch.invalid_indices().empty());
+        REQUIRE(batch.size() == 3u);
+        REQUIRE(batch.values().data() == values);
+        REQUIRE(batch[1].get_value() == 2);
+
+        auto vec = batch.to_vector();
+        REQUIRE(vec.size() == 3u);
+        REQUIRE(vec[0].get_value() == 1);
+        REQUIRE(vec[1].get_value() == 2);
+        REQUIRE(vec[2].get_value() == 3);
+    }
+    SECTION("invalid")
+    {
+        const int values[] = {1, 0, 3, 0, 0};
+
+        auto batch = constrain_all(make_array_ref(values), constraints::non_default{});
+        REQUIRE(!batch);
+        REQUIRE(batch.first_invalid() == 1u);
+        REQUIRE(batch.invalid_indices().size() == 3u);
+        REQUIRE(batch.invalid_indices()[0] == 1u);
+        REQUIRE(batch.invalid_indices()[1] == 3u);
+        REQUIRE(batch.invalid_indices()[2] == 4u);
+    }
+    SECTION("empty")
+    {
+        auto batch = constrain_all(array_ref<int>(nullptr, std::size_t(0u)), less_than{0});
+        REQUIRE(batch);
+        REQUIRE(batch.size() == 0u);
+        REQUIRE(batch.to_vector().empty());
+    }
+    SECTION("stateful")
+    {
+        int values[] = {1, 2, 3};
+
+        auto batch = constrain_all(make_array_ref(values), less_than{3});
+        REQUIRE(!batch);
+        REQUIRE(batch.first_invalid() == 2u);
+
+        batch = constrain_all(make_array_ref(values), less_than{4});
+        REQUIRE(batch);
+        REQUIRE(batch.get_constraint().bound == 4);
+        REQUIRE(batch[0].get_constraint().bound == 4);
+    }
+    SECTION("verifier")
+    {
+        int values[] = {1, 2, 3};
+
+        counting_verifier::count = 0;
+        auto batch = constrain_all<counting_verifier>(make_array_ref(values), less_than{4});
+        static_assert(std::is_same<decltype(batch)::value_type,
+                                   constrained_type<int, less_than, counting_verifier>>::value,
+                      "");
+        REQUIRE(batch);
+        REQUIRE(batch.to_vector().size() == 3u);
+        REQUIRE(counting_verifier::count == 0);
+    }
+}
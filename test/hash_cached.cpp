@@ -0,0 +1,90 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/hash_cached.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+#include <unordered_map>
+
+#include <type_safe/optional.hpp>
+#include <type_safe/strong_typedef.hpp>
+
+using namespace type_safe;
+
+namespace
+{
+    // counts the calls to the hash function
+    struct counting_hash
+    {
+        static int calls;
+
+        std::size_t operator()(const std::string& str) const
+        {
+            ++calls;
+            return std::hash<std::string>{}(str);
+        }
+    };
+
+    int counting_hash::calls = 0;
+
+    struct user_id : strong_typedef<user_id, hash_cached<std::string, counting_hash>>,
+                     strong_typedef_op::equality_comparision<user_id, bool>
+    {
+        using strong_typedef::strong_typedef;
+    };
+} // namespace
+
+namespace std
+{
+    template <>
+    struct hash<user_id> : type_safe::hashable<user_id>
+    {
+    };
+} // namespace std
+
+TEST_CASE("hash_cached")
+{
+    counting_hash::calls = 0;
+
+    SECTION("basic")
+    {
+        hash_cached<std::string, counting_hash> a("hello");
+        REQUIRE(a.get() == "hello");
+        REQUIRE(a.hash() == std::hash<std::string>{}("hello"));
+        REQUIRE(counting_hash::calls == 1);
+
+        using hasher = std::hash<hash_cached<std::string, counting_hash>>;
+        REQUIRE(hasher{}(a) == a.hash());
+        REQUIRE(hasher{}(a) == a.hash());
+        REQUIRE(counting_hash::calls == 1);
+
+        hash_cached<std::string, counting_hash> b("hello");
+        hash_cached<std::string, counting_hash> c("world");
+        REQUIRE(a == b);
+        REQUIRE(a != c);
+        REQUIRE(counting_hash::calls == 3);
+    }
+    SECTION("optional")
+    {
+        optional<hash_cached<std::string, counting_hash>> a(
+            hash_cached<std::string, counting_hash>("hello"));
+        REQUIRE(std::hash<decltype(a)>{}(a) == a.value().hash());
+        REQUIRE(counting_hash::calls == 1);
+    }
+    SECTION("strong_typedef")
+    {
+        std::unordered_map<user_id, int> map;
+        map.emplace(user_id(hash_cached<std::string, counting_hash>("alice")), 1);
+        map.emplace(user_id(hash_cached<std::string, counting_hash>("bob")), 2);
+        REQUIRE(counting_hash::calls == 2);
+
+        user_id bob(hash_cached<std::string, counting_hash>("bob"));
+        REQUIRE(counting_hash::calls == 3);
+        for (auto i = 0; i != 10; ++i)
+            REQUIRE(map.at(bob) == 2);
+        REQUIRE(counting_hash::calls == 3);
+    }
+}
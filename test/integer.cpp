@@ -286,3 +286,116 @@ TEST_CASE("integer")
         REQUIRE(static_cast<int>(i) == 10);
     }
 }
+
+TEST_CASE("integer policy")
+{
+    SECTION("wrapping_arithmetic")
+    {
+        using uint_t  = integer<unsigned, wrapping_arithmetic>;
+        using short_t = integer<short, wrapping_arithmetic>;
+
+        uint_t a(std::numeric_limits<unsigned>::max());
+        REQUIRE(static_cast<unsigned>(++a) == 0u);
+        REQUIRE(static_cast<unsigned>(a--) == 0u);
+        REQUIRE(static_cast<unsigned>(a) == std::numeric_limits<unsigned>::max());
+        a += 2u;
+        REQUIRE(static_cast<unsigned>(a) == 1u);
+        a -= uint_t(2u);
+        REQUIRE(static_cast<unsigned>(a) == std::numeric_limits<unsigned>::max());
+        a *= 2u;
+        REQUIRE(static_cast<unsigned>(a) == std::numeric_limits<unsigned>::max() - 1u);
+        REQUIRE(static_cast<unsigned>(a + 3u) == 1u);
+        REQUIRE(static_cast<unsigned>(1u - uint_t(3u))
+                == std::numeric_limits<unsigned>::max() - 1u);
+
+        short_t b(std::numeric_limits<short>::min());
+        REQUIRE(static_cast<short>(-b) == std::numeric_limits<short>::min());
+        REQUIRE(static_cast<short>(--b) == std::numeric_limits<short>::max());
+        b /= short(-1);
+        REQUIRE(static_cast<short>(b) == -std::numeric_limits<short>::max());
+    }
+    SECTION("sticky_arithmetic")
+    {
+        using int_t = integer<int, sticky_arithmetic>;
+
+        overflow_scope scope;
+        int_t          a(std::numeric_limits<int>::max() / 2);
+        auto           b = a * 2 + 1;
+        REQUIRE(!scope.overflowed());
+        auto c = (b + 1) - 1;
+        REQUIRE(static_cast<int>(c) == std::numeric_limits<int>::max());
+        REQUIRE(scope.overflowed());
+    }
+    SECTION("compound assignment with smaller type")
+    {
+        integer<int> a(1);
+        a += integer<short>(short(2));
+        a *= short(3);
+        REQUIRE(static_cast<int>(a) == 9);
+    }
+    SECTION("unary minus")
+    {
+        integer<short> a(short(5));
+        REQUIRE(static_cast<short>(-a) == -5);
+    }
+}
+
+#ifndef _MSC_VER
+static_assert(std::is_same<decltype(widen(integer<short>(short(0)))), integer<int>>::value, "");
+static_assert(std::is_same<decltype(widening_add(integer<int>(0), integer<short>(short(0)))),
+                           integer<long long>>::value,
+              "");
+static_assert(std::is_same<decltype(widening_subtract(integer<unsigned>(0u), integer<unsigned>(0u))),
+                           integer<long long>>::value,
+              "");
+static_assert(std::is_same<decltype(widening_multiply(integer<unsigned char>((unsigned char)0),
+                                                      integer<unsigned char>((unsigned char)0))),
+                           integer<unsigned short>>::value,
+              "");
+#endif
+
+TEST_CASE("widening")
+{
+    auto max = std::numeric_limits<int>::max();
+    auto min = std::numeric_limits<int>::min();
+
+    SECTION("widen")
+    {
+        auto a = widen(integer<int>(max));
+        REQUIRE(static_cast<long long>(a + 1) == max + 1ll);
+    }
+    SECTION("add")
+    {
+        REQUIRE(static_cast<long long>(widening_add(integer<int>(max), integer<int>(max)))
+                == 2ll * max);
+        REQUIRE(static_cast<long long>(widening_add(integer<int>(min), integer<int>(-1)))
+                == min - 1ll);
+        REQUIRE(static_cast<unsigned long long>(
+                    widening_add(integer<unsigned>(std::numeric_limits<unsigned>::max()),
+                                 integer<unsigned>(1u)))
+                == std::numeric_limits<unsigned>::max() + 1ull);
+    }
+    SECTION("subtract")
+    {
+        REQUIRE(static_cast<long long>(widening_subtract(integer<int>(min), integer<int>(max)))
+                == min - static_cast<long long>(max));
+        REQUIRE(static_cast<long long>(widening_subtract(integer<unsigned>(1u), integer<unsigned>(3u)))
+                == -2ll);
+    }
+    SECTION("multiply")
+    {
+        REQUIRE(static_cast<long long>(widening_multiply(integer<int>(min), integer<int>(min)))
+                == static_cast<long long>(min) * min);
+        REQUIRE(static_cast<long long>(widening_multiply(integer<int>(max), integer<int>(-2)))
+                == -2ll * max);
+    }
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+    SECTION("128bit")
+    {
+        auto value = widening_multiply(integer<long long>(std::numeric_limits<long long>::max()),
+                                       integer<long long>(4));
+        REQUIRE(static_cast<detail::int128_t>(value) > 0);
+        REQUIRE(static_cast<detail::int128_t>(value) / 4 == std::numeric_limits<long long>::max());
+    }
+#endif
+}
@@ -17,6 +17,11 @@ TEST_CASE("narrow_cast<integer>")
 
     integer<short> c = narrow_cast<integer<short>>(a);
     REQUIRE(static_cast<short>(c) == 4);
+
+    // average without overflow: widen, compute and narrow once
+    integer<int> max(std::numeric_limits<int>::max());
+    integer<int> d = narrow_cast<int>(widening_add(max, max - 2) / 2);
+    REQUIRE(static_cast<int>(d) == std::numeric_limits<int>::max() - 1);
 }
 
 TEST_CASE("narrow_cast<floating_point>")
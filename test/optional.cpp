@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <cstring>
+
 using namespace type_safe;
 
 struct debugger_type
@@ -84,8 +86,71 @@ struct debugger_type
     }
 };
 
+// counts the constructor calls of all objects
+struct counting_type
+{
+    static int copies, moves, constructions;
+
+    int id;
+
+    counting_type(int id) : id(id)
+    {
+        ++constructions;
+    }
+
+    counting_type(counting_type&& other) : id(other.id)
+    {
+        ++moves;
+    }
+
+    counting_type(const counting_type& other) : id(other.id)
+    {
+        ++copies;
+    }
+
+    static void reset_counts()
+    {
+        copies = moves = constructions = 0;
+    }
+};
+
+int counting_type::copies        = 0;
+int counting_type::moves         = 0;
+int counting_type::constructions = 0;
+
+// T must be deducible from optional<T>
+template <typename T>
+T deduced_value(const optional<T>& opt)
+{
+    return opt.value();
+}
+
 TEST_CASE("optional")
 {
+    SECTION("deduction")
+    {
+        optional<int> a(42);
+        REQUIRE(deduced_value(a) == 42);
+    }
+    SECTION("trivial")
+    {
+        static_assert(std::is_trivially_copyable<optional<int>>::value, "");
+        static_assert(std::is_trivially_destructible<optional<int>>::value, "");
+        static_assert(std::is_trivially_copyable<optional_ref<int>>::value, "");
+        static_assert(std::is_trivially_copyable<
+                          sentinel_optional<int, value_sentinel<int, -1>>>::value,
+                      "");
+        static_assert(!std::is_trivially_copyable<optional<std::string>>::value, "");
+        static_assert(!std::is_trivially_destructible<optional<std::string>>::value, "");
+        static_assert(std::is_trivially_destructible<optional<debugger_type>>::value, "");
+        static_assert(!std::is_trivially_copyable<optional<debugger_type>>::value, "");
+
+        optional<int> a(4);
+        optional<int> b;
+        std::memcpy(&b, &a, sizeof(a));
+        REQUIRE(b.has_value());
+        REQUIRE(b.value() == 4);
+    }
     SECTION("constructor - empty")
     {
         optional<int> a;
@@ -364,6 +429,64 @@ TEST_CASE("optional")
         auto                    b_res = b.value_or(1);
         REQUIRE(b_res.id == 0);
     }
+    SECTION("value_or_else")
+    {
+        auto calls = 0;
+        auto f     = [&] {
+            ++calls;
+            return debugger_type(1);
+        };
+
+        optional<debugger_type> a;
+        auto                    a_res = a.value_or_else(f);
+        REQUIRE(a_res.id == 1);
+        REQUIRE(calls == 1);
+
+        optional<debugger_type> b(0);
+        auto                    b_res = b.value_or_else(f);
+        REQUIRE(b_res.id == 0);
+        REQUIRE(b_res.copy_ctor());
+        REQUIRE(calls == 1);
+
+        auto c_res = std::move(b).value_or_else(f);
+        REQUIRE(c_res.id == 0);
+        REQUIRE(c_res.move_ctor());
+        REQUIRE(calls == 1);
+    }
+    SECTION("rvalue")
+    {
+        // nothing is copied out of an rvalue optional
+        optional<counting_type> a(0);
+        counting_type::reset_counts();
+        auto a_res = std::move(a).value_or(1);
+        REQUIRE(a_res.id == 0);
+        REQUIRE(counting_type::copies == 0);
+        REQUIRE(counting_type::moves == 1);
+        REQUIRE(counting_type::constructions == 0);
+
+        counting_type::reset_counts();
+        auto b_res = std::move(a).value_or_else([] { return counting_type(1); });
+        REQUIRE(b_res.id == 0);
+        REQUIRE(counting_type::copies == 0);
+        REQUIRE(counting_type::constructions == 0);
+
+        counting_type::reset_counts();
+        auto c_res = std::move(a).map([](counting_type&& c) { return std::move(c); });
+        REQUIRE(c_res.value().id == 0);
+        REQUIRE(counting_type::copies == 0);
+
+        optional<optional<counting_type>> d(optional<counting_type>(0));
+        counting_type::reset_counts();
+        optional<counting_type> d_res = std::move(d).unwrap();
+        REQUIRE(d_res.value().id == 0);
+        REQUIRE(counting_type::copies == 0);
+
+        counting_type::reset_counts();
+        auto e_res =
+            std::move(d_res).bind([](counting_type&& c) { return make_optional(std::move(c)); });
+        REQUIRE(e_res.value().id == 0);
+        REQUIRE(counting_type::copies == 0);
+    }
     SECTION("unwrap")
     {
         optional<int> a;
@@ -757,3 +880,289 @@ TEST_CASE("optional_ref")
         REQUIRE(b_res.value().move_ctor());
     }
 }
+
+TEST_CASE("sentinel_optional")
+{
+    using int_opt    = sentinel_optional<int, value_sentinel<int, -1>>;
+    using double_opt = sentinel_optional<double, nan_sentinel<double>>;
+    using ptr_opt    = sentinel_optional<const int*, value_sentinel<const int*, nullptr>>;
+
+    static_assert(sizeof(int_opt) == sizeof(int), "");
+    static_assert(sizeof(double_opt) == sizeof(double), "");
+    static_assert(sizeof(ptr_opt) == sizeof(const int*), "");
+
+    SECTION("constructor")
+    {
+        int_opt a;
+        REQUIRE_FALSE(a.has_value());
+
+        int_opt b(nullopt);
+        REQUIRE_FALSE(b.has_value());
+
+        int_opt c(0);
+        REQUIRE(c.has_value());
+        REQUIRE(c.value() == 0);
+
+        int_opt d(c);
+        REQUIRE(d.has_value());
+        REQUIRE(d.value() == 0);
+    }
+    SECTION("assignment")
+    {
+        int_opt a;
+        a = 5;
+        REQUIRE(a.has_value());
+        REQUIRE(a.value() == 5);
+
+        a = nullopt;
+        REQUIRE_FALSE(a.has_value());
+
+        a.emplace(7);
+        REQUIRE(a.value() == 7);
+        a.reset();
+        REQUIRE_FALSE(a.has_value());
+    }
+    SECTION("value_or")
+    {
+        int_opt a;
+        REQUIRE(a.value_or(3) == 3);
+        a = 4;
+        REQUIRE(a.value_or(3) == 4);
+    }
+    SECTION("map/bind")
+    {
+        int_opt a(4);
+        auto    b = a.map([](int i) { return i - 5; });
+        REQUIRE(b.has_value());
+        REQUIRE(b.value() == -1); // rebound to optional, so the reserved value is allowed
+
+        auto c = a.bind([](int i) { return i > 0 ? int_opt(i * 2) : int_opt(nullopt); });
+        static_assert(std::is_same<decltype(c), int_opt>::value, "");
+        REQUIRE(c.has_value());
+        REQUIRE(c.value() == 8);
+
+        REQUIRE_FALSE(int_opt().map([](int i) { return i; }).has_value());
+    }
+    SECTION("visit")
+    {
+        struct visitor
+        {
+            int operator()(nullopt_t) const
+            {
+                return -10;
+            }
+
+            int operator()(int i) const
+            {
+                return i;
+            }
+        };
+
+        REQUIRE(visit(visitor{}, int_opt()) == -10);
+        REQUIRE(visit(visitor{}, int_opt(3)) == 3);
+    }
+    SECTION("nan")
+    {
+        double_opt a;
+        REQUIRE_FALSE(a.has_value());
+        a = 0.5;
+        REQUIRE(a.has_value());
+        REQUIRE(a.value() == 0.5);
+        a.reset();
+        REQUIRE_FALSE(a.has_value());
+    }
+    SECTION("pointer")
+    {
+        int     i = 0;
+        ptr_opt a;
+        REQUIRE_FALSE(a.has_value());
+        a = &i;
+        REQUIRE(a.has_value());
+        REQUIRE(a.value() == &i);
+    }
+}
+
+namespace
+{
+    constexpr int twice(int i)
+    {
+        return 2 * i;
+    }
+} // namespace
+
+TEST_CASE("constexpr_optional")
+{
+    using opt = constexpr_optional<int>;
+    static_assert(std::is_trivially_copyable<opt>::value, "");
+
+    SECTION("constant expressions")
+    {
+        constexpr opt a;
+        constexpr opt b(4);
+        static_assert(!a.has_value() && !a, "");
+        static_assert(b.has_value() && b.value() == 4, "");
+        static_assert(a.value_or(3) == 3 && b.value_or(3) == 4, "");
+        static_assert(!a.map(twice).has_value() && b.map(twice) == 8, "");
+        static_assert(a.transform(-1, twice) == -1 && b.transform(-1, twice) == 8, "");
+        static_assert(a == nullopt && b != nullopt && b == 4 && 4 == b, "");
+        static_assert(a < b && a != b && b > 3 && !(b < 4), "");
+
+        constexpr opt table[] = {opt(1), opt(nullopt), opt(3)};
+        static_assert(table[0].value() == 1 && !table[1].has_value() && table[2] == 3, "");
+    }
+    SECTION("runtime")
+    {
+        opt a;
+        REQUIRE_FALSE(a.has_value());
+
+        a = 5;
+        REQUIRE(a.value() == 5);
+        a.value() = 6;
+        REQUIRE(a == 6);
+
+        opt b(a);
+        REQUIRE(b.value() == 6);
+
+        a.reset();
+        REQUIRE_FALSE(a.has_value());
+        a.emplace(7);
+        REQUIRE(a.value() == 7);
+
+        auto c = a.map([](int i) { return std::string(std::size_t(i), 'a'); });
+        static_assert(std::is_same<decltype(c), optional<std::string>>::value, "");
+        REQUIRE(c.value() == "aaaaaaa");
+    }
+}
+
+namespace
+{
+    struct shape
+    {
+        static int alive;
+
+        shape()
+        {
+            ++alive;
+        }
+
+        shape(const shape&)
+        {
+            ++alive;
+        }
+
+        virtual ~shape()
+        {
+            --alive;
+        }
+
+        virtual int area() const = 0;
+    };
+
+    int shape::alive = 0;
+
+    struct square : shape
+    {
+        int length;
+
+        explicit square(int l) : length(l)
+        {
+        }
+
+        int area() const override
+        {
+            return length * length;
+        }
+    };
+
+    struct padding
+    {
+        long long value = 0;
+    };
+
+    // shape is not at the beginning of the object
+    struct rectangle : padding, shape
+    {
+        int width, height;
+
+        rectangle(int w, int h) : width(w), height(h)
+        {
+        }
+
+        int area() const override
+        {
+            return width * height;
+        }
+    };
+} // namespace
+
+TEST_CASE("polymorphic_optional")
+{
+    using opt = polymorphic_optional<shape, 32>;
+    shape::alive = 0;
+
+    SECTION("constructor")
+    {
+        opt a;
+        REQUIRE_FALSE(a.has_value());
+
+        opt b(square(3));
+        REQUIRE(b.has_value());
+        REQUIRE(b.value().area() == 9);
+
+        rectangle r(2, 3);
+        opt       c(r);
+        REQUIRE(c.value().area() == 6);
+        REQUIRE(&c.value() != static_cast<shape*>(&r));
+    }
+    SECTION("copy/move")
+    {
+        opt a(rectangle(2, 3));
+
+        opt b(a);
+        REQUIRE(b.value().area() == 6);
+        REQUIRE(dynamic_cast<rectangle*>(&b.value()));
+
+        opt c(std::move(b));
+        REQUIRE(c.value().area() == 6);
+
+        opt d(square(2));
+        d = a;
+        REQUIRE(d.value().area() == 6);
+
+        d = opt(square(4));
+        REQUIRE(d.value().area() == 16);
+        REQUIRE(dynamic_cast<square*>(&d.value()));
+
+        d = opt();
+        REQUIRE_FALSE(d.has_value());
+    }
+    SECTION("modifiers")
+    {
+        opt a;
+        a = square(2);
+        REQUIRE(a.value().area() == 4);
+
+        a.emplace(rectangle(1, 5));
+        REQUIRE(a.value().area() == 5);
+
+        opt b(square(3));
+        swap(a, b);
+        REQUIRE(a.value().area() == 9);
+        REQUIRE(b.value().area() == 5);
+
+        opt c;
+        swap(a, c);
+        REQUIRE_FALSE(a.has_value());
+        REQUIRE(c.value().area() == 9);
+
+        auto area = c.map([](const shape& s) { return s.area(); });
+        static_assert(std::is_same<decltype(area), optional<int>>::value, "");
+        REQUIRE(area.value() == 9);
+
+        REQUIRE(shape::alive == 2);
+        b.reset();
+        c.reset();
+        REQUIRE(shape::alive == 0);
+    }
+    REQUIRE(shape::alive == 0);
+}
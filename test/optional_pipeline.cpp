@@ -0,0 +1,134 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/optional_pipeline.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+    struct counter
+    {
+        static int moves, copies;
+
+        int value;
+
+        counter(int v) : value(v)
+        {
+        }
+
+        counter(counter&& other) : value(other.value)
+        {
+            ++moves;
+        }
+
+        counter(const counter& other) : value(other.value)
+        {
+            ++copies;
+        }
+    };
+
+    int counter::moves  = 0;
+    int counter::copies = 0;
+} // namespace
+
+TEST_CASE("optional_pipeline")
+{
+    auto append = [](std::string s) { return s + "!"; };
+    auto length = [](const std::string& s) { return s.size(); };
+    auto longer = [](const std::string& s) { return s.size() > 3u; };
+
+    SECTION("map")
+    {
+        optional<std::string> a("hi");
+        REQUIRE((a | pipeline::map(append) | pipeline::map(append) | pipeline::value_or(""))
+                == "hi!!");
+        REQUIRE(a.value() == "hi");
+
+        optional<std::string> b;
+        REQUIRE((b | pipeline::map(append) | pipeline::value_or("empty")) == "empty");
+
+        auto c = a | pipeline::map(length) | pipeline::to_optional();
+        static_assert(std::is_same<decltype(c), optional<std::size_t>>::value, "");
+        REQUIRE(c.value() == 2u);
+        REQUIRE_FALSE((b | pipeline::map(length) | pipeline::to_optional()).has_value());
+    }
+    SECTION("filter")
+    {
+        optional<std::string> a("hi");
+        REQUIRE((a | pipeline::filter(longer) | pipeline::value_or("short")) == "short");
+        REQUIRE((a | pipeline::map(append) | pipeline::map(append) | pipeline::filter(longer)
+                 | pipeline::value_or("short"))
+                == "hi!!");
+        REQUIRE_FALSE((a | pipeline::filter(longer) | pipeline::to_optional()).has_value());
+    }
+    SECTION("bind")
+    {
+        auto half = [](int i) { return i % 2 == 0 ? make_optional(i / 2) : nullopt; };
+
+        REQUIRE((optional<int>(8) | pipeline::bind(half) | pipeline::bind(half)
+                 | pipeline::value_or(-1))
+                == 2);
+        REQUIRE((optional<int>(6) | pipeline::bind(half) | pipeline::bind(half)
+                 | pipeline::value_or(-1))
+                == -1);
+        REQUIRE((optional<int>() | pipeline::bind(half) | pipeline::value_or(-1)) == -1);
+    }
+    SECTION("terminal only")
+    {
+        optional<int> a(4);
+        REQUIRE((a | pipeline::value_or(0)) == 4);
+        REQUIRE((a | pipeline::to_optional()).value() == 4);
+        REQUIRE((optional<int>() | pipeline::value_or(0)) == 0);
+    }
+    SECTION("lifetime")
+    {
+        // an rvalue optional is stored in the pipeline
+        auto a = optional<std::string>("hello") | pipeline::map(append);
+        REQUIRE((std::move(a) | pipeline::value_or("")) == "hello!");
+
+        // an lvalue optional is referenced
+        optional<std::string> b("hi");
+        auto                  c = b | pipeline::map(append);
+        b.value()               = "hey";
+        REQUIRE((std::move(c) | pipeline::value_or("")) == "hey!");
+    }
+    SECTION("no intermediate optionals")
+    {
+        counter::moves  = 0;
+        counter::copies = 0;
+
+        // the rvalue optional is moved into the pipeline, only count the evaluation
+        optional<counter> a(counter(1));
+        auto pipe = std::move(a) | pipeline::map([](counter&& c) { return std::move(c); })
+                    | pipeline::map([](counter c) {
+                          c.value *= 2;
+                          return c;
+                      });
+        counter::moves = 0;
+
+        auto result = std::move(pipe) | pipeline::value_or(0);
+        REQUIRE(result.value == 2);
+        REQUIRE(counter::copies == 0);
+
+        auto chained_moves = counter::moves;
+        counter::moves     = 0;
+
+        optional<counter> b(counter(1));
+        counter::moves = 0;
+        auto chained   = std::move(b)
+                           .map([](counter&& c) { return std::move(c); })
+                           .map([](counter c) {
+                               c.value *= 2;
+                               return c;
+                           })
+                           .value_or(0);
+        REQUIRE(chained.value == 2);
+        REQUIRE(chained_moves < counter::moves);
+    }
+}
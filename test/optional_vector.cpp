@@ -0,0 +1,274 @@
+// Copyright (C) 2016 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <type_safe/optional_vector.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace type_safe;
+
+namespace
+{
+    // only visits elements with a value
+    struct sum_visitor
+    {
+        using incomplete_visitor = void;
+
+        int sum = 0, count = 0;
+
+        void operator()(int x)
+        {
+            sum += x;
+            ++count;
+        }
+    };
+} // namespace
+
+TEST_CASE("optional_vector")
+{
+    SECTION("constructor")
+    {
+        optional_vector<int> a;
+        REQUIRE(a.empty());
+        REQUIRE(a.size() == 0u);
+        REQUIRE(a.count_present() == 0u);
+        REQUIRE(a.begin() == a.end());
+
+        optional_vector<int> b(100u);
+        REQUIRE(b.size() == 100u);
+        REQUIRE(b.count_present() == 0u);
+        for (auto i = 0u; i != b.size(); ++i)
+            REQUIRE(!b.has_value(i));
+    }
+    SECTION("push_back")
+    {
+        optional_vector<int> a;
+        for (auto i = 0; i != 200; ++i)
+        {
+            if (i % 3 == 0)
+                a.push_back(nullopt);
+            else
+                a.push_back(i);
+        }
+        REQUIRE(a.size() == 200u);
+        REQUIRE(a.count_present() == 133u);
+
+        for (auto i = 0; i != 200; ++i)
+        {
+            auto ref = a[std::size_t(i)];
+            REQUIRE(ref.has_value() == (i % 3 != 0));
+            if (ref.has_value())
+                REQUIRE(ref.value() == i);
+        }
+
+        a.clear();
+        REQUIRE(a.empty());
+        REQUIRE(a.count_present() == 0u);
+    }
+    SECTION("modification")
+    {
+        optional_vector<int> a(70u);
+        a.set_value(3u, 3);
+        a.set_value(65u, 65);
+        REQUIRE(a.count_present() == 2u);
+        REQUIRE(a[65u].value() == 65);
+
+        a[3u].value() = 4;
+        REQUIRE(a.values()[3u] == 4);
+
+        a.reset(3u);
+        REQUIRE(!a.has_value(3u));
+        REQUIRE(a.count_present() == 1u);
+
+        const auto& b = a;
+        REQUIRE(!b[3u].has_value());
+        REQUIRE(b[65u].value() == 65);
+    }
+    SECTION("iterator")
+    {
+        optional_vector<int> a;
+        a.push_back(1);
+        a.push_back(nullopt);
+        a.push_back(3);
+
+        auto sum = 0, missing = 0;
+        for (auto ref : a)
+        {
+            if (ref)
+                sum += ref.value();
+            else
+                ++missing;
+        }
+        REQUIRE(sum == 4);
+        REQUIRE(missing == 1);
+
+        optional_vector<int>::const_iterator iter = a.begin();
+        REQUIRE((*iter).value() == 1);
+        ++iter;
+        REQUIRE(!(*iter).has_value());
+        iter++;
+        REQUIRE((*iter).value() == 3);
+        REQUIRE(++iter == a.end());
+
+        for (auto ref : a)
+            if (ref)
+                ref.value() *= 2;
+        REQUIRE(a[2u].value() == 6);
+    }
+    SECTION("fill_missing")
+    {
+        optional_vector<int> a;
+        for (auto i = 0; i != 130; ++i)
+        {
+            if (i < 64 || i % 2 == 0)
+                a.push_back(i);
+            else
+                a.push_back(nullopt);
+        }
+
+        a.fill_missing(-1);
+        REQUIRE(a.count_present() == 130u);
+        for (auto i = 0; i != 130; ++i)
+            REQUIRE(a[std::size_t(i)].value() == (i < 64 || i % 2 == 0 ? i : -1));
+
+        optional_vector<std::string> b(3u);
+        b.set_value(1u, "a");
+        b.fill_missing("b");
+        REQUIRE(b[0u].value() == "b");
+        REQUIRE(b[1u].value() == "a");
+        REQUIRE(b[2u].value() == "b");
+    }
+    SECTION("map")
+    {
+        optional_vector<int> a;
+        for (auto i = 0; i != 150; ++i)
+        {
+            if (i < 64 || i % 5 != 0)
+                a.push_back(i);
+            else
+                a.push_back(nullopt);
+        }
+
+        auto calls = 0u;
+        auto b     = a.map([&](int i) {
+            ++calls;
+            return i * 0.5;
+        });
+        static_assert(std::is_same<decltype(b), optional_vector<double>>::value, "");
+        REQUIRE(calls == a.count_present());
+        REQUIRE(b.size() == a.size());
+        REQUIRE(b.count_present() == a.count_present());
+        for (auto i = 0; i != 150; ++i)
+        {
+            REQUIRE(b.has_value(std::size_t(i)) == a.has_value(std::size_t(i)));
+            if (b.has_value(std::size_t(i)))
+                REQUIRE(b[std::size_t(i)].value() == i * 0.5);
+        }
+    }
+    SECTION("apply")
+    {
+        optional_vector<int> a, b;
+        for (auto i = 0; i != 150; ++i)
+        {
+            if (i < 64 || i % 5 != 0)
+                a.push_back(i);
+            else
+                a.push_back(nullopt);
+
+            if (i < 64 || i % 3 != 0)
+                b.push_back(2 * i);
+            else
+                b.push_back(nullopt);
+        }
+
+        auto calls = 0u;
+        auto c     = apply(
+            [&](int x, int y) {
+                ++calls;
+                return x + y;
+            },
+            a, b);
+        static_assert(std::is_same<decltype(c), optional_vector<int>>::value, "");
+        REQUIRE(c.size() == a.size());
+        REQUIRE(calls == c.count_present());
+        for (auto i = 0; i != 150; ++i)
+        {
+            auto idx = std::size_t(i);
+            REQUIRE(c.has_value(idx) == (a.has_value(idx) && b.has_value(idx)));
+            if (c.has_value(idx))
+                REQUIRE(c[idx].value() == 3 * i);
+        }
+
+        auto d = apply([](int x) { return x % 2; }, a);
+        REQUIRE(d.count_present() == a.count_present());
+        REQUIRE(d[4u].value() == 0);
+        REQUIRE(d[5u].value() == 1);
+    }
+    SECTION("visit")
+    {
+        optional_vector<int> a;
+        optional_vector<std::string> b;
+        for (auto i = 0; i != 100; ++i)
+        {
+            a.push_back(i);
+            if (i % 4 == 0)
+                b.push_back(nullopt);
+            else
+                b.push_back("a");
+        }
+        a.reset(70u);
+
+        struct visitor
+        {
+            int both = 0, first = 0, second = 0, none = 0;
+
+            void operator()(int, const std::string&)
+            {
+                ++both;
+            }
+
+            void operator()(int, nullopt_t)
+            {
+                ++first;
+            }
+
+            void operator()(nullopt_t, const std::string&)
+            {
+                ++second;
+            }
+
+            void operator()(nullopt_t, nullopt_t)
+            {
+                ++none;
+            }
+        } v;
+        visit(v, a, b);
+        REQUIRE(v.both == 74);
+        REQUIRE(v.first == 25);
+        REQUIRE(v.second == 1);
+        REQUIRE(v.none == 0);
+
+        // first group has all values, second one does not
+        optional_vector<int> c;
+        for (auto i = 0; i != 100; ++i)
+            c.push_back(i);
+        c.reset(99u);
+
+        sum_visitor sv;
+        visit(sv, c);
+        REQUIRE(sv.count == 99);
+        REQUIRE(sv.sum == 99 * 98 / 2);
+
+        optional_vector<std::string> d;
+        for (auto i = 0; i != 100; ++i)
+            d.push_back("a");
+
+        visitor cv;
+        visit(cv, c, d);
+        REQUIRE(cv.both == 99);
+        REQUIRE(cv.second == 1);
+    }
+}
@@ -6,10 +6,29 @@
 
 #include <catch.hpp>
 
+#include <map>
 #include <sstream>
+#include <string>
 
 using namespace type_safe;
 
+namespace
+{
+    struct hashable_type : strong_typedef<hashable_type, std::string>,
+                           strong_typedef_op::equality_comparision<hashable_type, bool>
+    {
+        using strong_typedef::strong_typedef;
+    };
+} // namespace
+
+namespace std
+{
+    template <>
+    struct hash<hashable_type> : type_safe::hashable<hashable_type>
+    {
+    };
+} // namespace std
+
 TEST_CASE("strong_typedef")
 {
     SECTION("equality_comparision")
@@ -265,4 +284,39 @@ TEST_CASE("strong_typedef")
         in >> a;
         REQUIRE(static_cast<int>(a) == 1);
     }
+    SECTION("hashable")
+    {
+        hashable_type a("hello");
+        REQUIRE(std::hash<hashable_type>{}(a) == std::hash<std::string>{}("hello"));
+    }
+    SECTION("transparent")
+    {
+        hashable_type a("a"), b("b");
+
+        strong_typedef_op::transparent_less<hashable_type> less;
+        REQUIRE(less(a, b));
+        REQUIRE(!less(b, a));
+        REQUIRE(less(a, "b"));
+        REQUIRE(!less("b", a));
+        REQUIRE(less(std::string("a"), b));
+
+        strong_typedef_op::transparent_equal<hashable_type> equal;
+        REQUIRE(equal(a, a));
+        REQUIRE(!equal(a, b));
+        REQUIRE(equal(a, "a"));
+        REQUIRE(equal(std::string("b"), b));
+
+        strong_typedef_op::transparent_hash<hashable_type> hash;
+        REQUIRE(hash(a) == std::hash<std::string>{}("a"));
+        REQUIRE(hash(std::string("a")) == hash(a));
+
+#if defined(__cpp_lib_generic_associative_lookup)
+        std::map<hashable_type, int, strong_typedef_op::transparent_less<hashable_type>> map;
+        map.emplace(a, 1);
+        map.emplace(b, 2);
+        REQUIRE(map.find("a")->second == 1);
+        REQUIRE(map.find(std::string("b"))->second == 2);
+        REQUIRE(map.find("c") == map.end());
+#endif
+    }
 }